@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+/**
+ * Times small pieces of DSP code. The code runs in batches long enough for
+ * the clock to be accurate, a few times over, and the fastest batch wins.
+ * The fastest batch is the one the OS and other processes got in the way
+ * of the least, which makes results comparable from one run to the next.
+ *
+ * @since 2026 Oct 16
+ */
+class BenchmarkTimer
+{
+public:
+
+    //! The number of batches timed per measurement. The fastest one counts.
+    static constexpr int NUM_BATCHES = 5;
+
+    /**
+     * How long one sample took.
+     */
+    struct Measurement
+    {
+        double nsPerSample = 0.0;      //!< Wall clock time per sample, in nanoseconds.
+        double cyclesPerSample = -1.0; //!< Time stamp counter ticks per sample. Negative if the CPU has no TSC.
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param minSeconds How long a measurement should take, at least.
+     */
+    explicit BenchmarkTimer(double minSeconds)
+        : m_minSeconds(minSeconds)
+    {
+    }
+
+    /**
+     * Times the given function.
+     *
+     * @param samplesPerRun The number of samples one call of run processes.
+     * @param run The code to time. Called many times over.
+     */
+    template <typename Function>
+    Measurement measure(juce::int64 samplesPerRun, Function &&run) const
+    {
+        // Warm up the caches and branch predictors, and find out how many
+        // runs fill a batch.
+        juce::int64 runsPerBatch = 1;
+        for (;;)
+        {
+            const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+            for (juce::int64 i = 0; i < runsPerBatch; ++i)
+                run();
+            const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+            const double batchSeconds = m_minSeconds / NUM_BATCHES;
+            if (seconds >= batchSeconds)
+                break;
+
+            const double scale = (seconds > 0.0) ? std::min(batchSeconds / seconds * 1.2, 100.0) : 100.0;
+            runsPerBatch = std::max(runsPerBatch + 1, static_cast<juce::int64>(runsPerBatch * scale));
+        }
+
+        Measurement best;
+        best.nsPerSample = std::numeric_limits<double>::max();
+
+        for (int batch = 0; batch < NUM_BATCHES; ++batch)
+        {
+            const uint64_t startCycles = readTimeStampCounter();
+            const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+            for (juce::int64 i = 0; i < runsPerBatch; ++i)
+                run();
+            const juce::int64 endTicks = juce::Time::getHighResolutionTicks();
+            const uint64_t endCycles = readTimeStampCounter();
+
+            const double numSamples = static_cast<double>(runsPerBatch * samplesPerRun);
+            const double nsPerSample = juce::Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1e9 / numSamples;
+            if (nsPerSample < best.nsPerSample)
+            {
+                best.nsPerSample = nsPerSample;
+                best.cyclesPerSample = hasTimeStampCounter() ? (endCycles - startCycles) / numSamples : -1.0;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * Returns true if cycles can be counted on this machine.
+     */
+    static constexpr bool hasTimeStampCounter()
+    {
+#if JUCE_INTEL
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Reads the CPU's time stamp counter. It ticks at a constant rate on
+     * modern CPUs, which is the base clock rather than the turbo clock, so
+     * "cycles" are only comparable on the same machine. Returns 0 where
+     * there's no counter.
+     */
+    static uint64_t readTimeStampCounter()
+    {
+#if JUCE_INTEL
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+private:
+
+    const double m_minSeconds; //!< How long a measurement should take, at least.
+};
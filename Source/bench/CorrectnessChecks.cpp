@@ -0,0 +1,539 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "bench/CorrectnessChecks.h"
+#include "dsp/EnvelopeTable.h"
+#include "dsp/PhaseAccumulator.h"
+#include "dsp/SineKernel.h"
+#include "dsp/TremoloAudioProcessor.h"
+#include "dsp/TremoloBank.h"
+#include "render/OfflineRenderer.h"
+#include "render/ParallelRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    //! A parameter ID and the text to set it to.
+    using ParameterSetting = std::pair<const char *, const char *>;
+
+    /**
+     * Turns one check into a JSON object.
+     *
+     * @param name The check.
+     * @param caseName What was checked, if the check covers more than one case. May be empty.
+     * @param passed True if the check passed.
+     */
+    juce::DynamicObject *makeResult(const juce::String &name, const juce::String &caseName, bool passed)
+    {
+        auto *pResult = new juce::DynamicObject();
+        pResult->setProperty("check", name);
+        if (caseName.isNotEmpty())
+            pResult->setProperty("case", caseName);
+        pResult->setProperty("passed", passed);
+        return pResult;
+    }
+
+    /**
+     * Sets processor parameters by ID from text, the way a user would type them in.
+     */
+    void setParameters(juce::AudioProcessor &processor, const std::vector<ParameterSetting> &settings)
+    {
+        for (const ParameterSetting &setting : settings)
+        {
+            for (juce::AudioProcessorParameter *pParameter : processor.getParameters())
+            {
+                auto *pRangedParameter = dynamic_cast<juce::RangedAudioParameter *>(pParameter);
+                if (pRangedParameter && pRangedParameter->getParameterID() == setting.first)
+                    pRangedParameter->setValueNotifyingHost(pRangedParameter->getValueForText(setting.second));
+            }
+        }
+    }
+
+    /**
+     * Writes a few seconds of stereo noise with a silent stretch in the
+     * middle, so the processor's silence hold gets a workout too.
+     */
+    void writeTestInput(const juce::File &file, double sampleRate, int numChannels, int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        juce::Random random(1);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+        }
+        buffer.clear(numSamples / 3, numSamples / 6);
+
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatWriter> spWriter(format.createWriterFor(new juce::FileOutputStream(file),
+            sampleRate, static_cast<unsigned int>(numChannels), 24, {}, 0));
+        if (!spWriter || !spWriter->writeFromAudioSampleBuffer(buffer, 0, numSamples))
+            throw std::runtime_error("Couldn't write " + file.getFullPathName().toStdString());
+    }
+
+    /**
+     * Reads a whole file.
+     */
+    juce::AudioBuffer<float> readWholeFile(juce::AudioFormatManager &formatManager, const juce::File &file)
+    {
+        std::unique_ptr<juce::AudioFormatReader> spReader(formatManager.createReaderFor(file));
+        if (!spReader)
+            throw std::runtime_error("Couldn't read " + file.getFullPathName().toStdString());
+
+        juce::AudioBuffer<float> buffer(static_cast<int>(spReader->numChannels), static_cast<int>(spReader->lengthInSamples));
+        spReader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        return buffer;
+    }
+
+    /**
+     * Returns the largest difference between two buffers of the same size.
+     */
+    double getMaxDifference(const juce::AudioBuffer<float> &a, const juce::AudioBuffer<float> &b)
+    {
+        double maxDifference = 0.0;
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+        {
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                maxDifference = std::max(maxDifference, std::abs(static_cast<double>(a.getSample(channel, i)) - b.getSample(channel, i)));
+        }
+        return maxDifference;
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+CorrectnessChecks::CorrectnessChecks(const juce::String &filter)
+    : m_filter(filter)
+{
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+juce::Array<juce::var> CorrectnessChecks::run(const std::function<void(const juce::String &)> &onProgress)
+{
+    struct Check
+    {
+        const char *pName;
+        void (CorrectnessChecks::*pRun)(juce::Array<juce::var> &);
+    };
+
+    const Check checks[] =
+    {
+        { "SineKernel::renderBlock",   &CorrectnessChecks::checkSinePrecision },
+        { "PhaseAccumulator::advance", &CorrectnessChecks::checkPhaseAccumulator },
+        { "TremoloBank::process",      &CorrectnessChecks::checkTremoloBank },
+        { "ControlRateLfo::render",    &CorrectnessChecks::checkControlRateLfo },
+        { "ParallelRenderer::render",  &CorrectnessChecks::checkParallelRender },
+    };
+
+    juce::Array<juce::var> results;
+    for (const Check &check : checks)
+    {
+        if (m_filter.isNotEmpty() && !juce::String(check.pName).containsIgnoreCase(m_filter))
+            continue;
+
+        if (onProgress)
+            onProgress(check.pName);
+        (this->*check.pRun)(results);
+    }
+
+    return results;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+bool CorrectnessChecks::allPassed(const juce::Array<juce::var> &results)
+{
+    return std::all_of(results.begin(), results.end(), [](const juce::var &result) { return static_cast<bool>(result["passed"]); });
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void CorrectnessChecks::checkSinePrecision(juce::Array<juce::var> &results)
+{
+    constexpr int numPhases = 10000000;
+    constexpr double phaseDelta = 1.0 / numPhases;
+    constexpr int blockSize = 4096;
+
+    const std::pair<const char *, SinePrecision> tiers[] =
+    {
+        { "Fast",     SinePrecision::Fast },
+        { "Standard", SinePrecision::Standard },
+        { "High",     SinePrecision::High },
+    };
+
+    std::vector<double> values(static_cast<size_t>(blockSize));
+    for (const auto &tier : tiers)
+    {
+        const WaveShapes::BlockRenderFunction renderBlock = SineKernel::getBlockRenderer(tier.second);
+        EnvelopeTable table;
+        table.build(renderBlock, SineKernel::getTableSize(tier.second));
+        double maxError = 0.0;
+        double maxTableError = 0.0;
+
+        for (int blockStart = 0; blockStart < numPhases; blockStart += blockSize)
+        {
+            // The kernel works out every phase as start + delta * i, so we do too.
+            const int numValues = std::min(blockSize, numPhases - blockStart);
+            const double startPhase = blockStart * phaseDelta;
+            renderBlock(startPhase, phaseDelta, values.data(), numValues);
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                const double phase = startPhase + phaseDelta * i;
+                const double expected = WaveShapes::sine(phase);
+                maxError = std::max(maxError, std::abs(values[static_cast<size_t>(i)] - expected));
+                maxTableError = std::max(maxTableError, std::abs(table.valueAt(phase) - expected));
+            }
+        }
+
+        // What the tremolo actually uses is the table, so that's the bound
+        // that counts. The polynomial on its own has to leave room for it.
+        const double bound = SineKernel::maxPolynomialError(tier.second);
+        const double tableBound = SineKernel::maxAbsoluteError(tier.second);
+        juce::DynamicObject *pResult = makeResult("SineKernel::renderBlock", tier.first, maxError < bound && maxTableError < tableBound);
+        pResult->setProperty("maxError", maxError);
+        pResult->setProperty("bound", bound);
+        pResult->setProperty("tableSize", table.getSize());
+        pResult->setProperty("maxTableError", maxTableError);
+        pResult->setProperty("tableBound", tableBound);
+        results.add(juce::var(pResult));
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void CorrectnessChecks::checkPhaseAccumulator(juce::Array<juce::var> &results)
+{
+    constexpr uint64_t numSamples = 100000000000; // 10^11, about 24 days at 48 kHz.
+    constexpr int jumpSize = 1 << 30;
+
+    // Frequencies are numerator / denominator Hz, with power of 2
+    // denominators so they're exact doubles. The phase after n samples is
+    // then exactly (n * numerator mod period) / period, where period is
+    // denominator * sample rate.
+    struct Case
+    {
+        const char *pName;
+        uint64_t numerator;
+        uint64_t denominator;
+        uint64_t sampleRate;
+    };
+
+    const Case cases[] =
+    {
+        { "40 Hz at 44.1 kHz",     40,  1, 44100 },
+        { "7.25 Hz at 48 kHz",     29,  4, 48000 },
+        { "16.375 Hz at 96 kHz",  131,  8, 96000 },
+        { "1 Hz at 192 kHz",        1,  1, 192000 },
+    };
+
+    // Every sample adds the rounding of frequency / sample rate to long
+    // double plus the rounding of the increment to 2^-64, and reading the
+    // phase back as a double drops up to 2^-53 more.
+    const double errorPerSample = std::ldexp(1.0, -(std::numeric_limits<long double>::digits + 1)) + std::ldexp(1.0, -65);
+
+    for (const Case &testCase : cases)
+    {
+        const uint64_t period = testCase.denominator * testCase.sampleRate;
+        PhaseAccumulator phaseAccumulator;
+        phaseAccumulator.setSampleRate(static_cast<double>(testCase.sampleRate));
+        phaseAccumulator.setFrequency(static_cast<double>(testCase.numerator) / static_cast<double>(testCase.denominator));
+
+        uint64_t position = 0;
+        double maxError = 0.0;
+        while (position < numSamples)
+        {
+            phaseAccumulator.advance(jumpSize);
+            position += jumpSize;
+
+            // Both factors are below period, which is small enough that
+            // their product can't overflow.
+            const uint64_t cycles = ((position % period) * (testCase.numerator % period)) % period;
+            const long double exactPhase = static_cast<long double>(cycles) / period;
+            double error = std::abs(static_cast<double>(exactPhase - phaseAccumulator.getPhase()));
+            error = std::min(error, 1.0 - error);
+            maxError = std::max(maxError, error);
+        }
+
+        // advance() and setPosition() have to land on the very same bits.
+        const double advancedPhase = phaseAccumulator.getPhase();
+        phaseAccumulator.setPosition(position);
+        const bool isSameAsPosition = (phaseAccumulator.getPhase() == advancedPhase);
+
+        const double bound = static_cast<double>(position) * errorPerSample + std::ldexp(1.0, -52);
+        juce::DynamicObject *pResult = makeResult("PhaseAccumulator::advance", testCase.pName, maxError < bound && isSameAsPosition);
+        pResult->setProperty("numSamples", static_cast<juce::int64>(position));
+        pResult->setProperty("maxError", maxError);
+        pResult->setProperty("bound", bound);
+        pResult->setProperty("isSameAsPosition", isSameAsPosition);
+        results.add(juce::var(pResult));
+    }
+
+    // A tiny negative phase wraps to exactly 1.0, which has to come out as 0.0.
+    PhaseAccumulator phaseAccumulator;
+    phaseAccumulator.setPhase(-1e-20);
+    juce::DynamicObject *pResult = makeResult("PhaseAccumulator::advance", "setPhase(-1e-20)", phaseAccumulator.getPhase() == 0.0);
+    pResult->setProperty("phase", phaseAccumulator.getPhase());
+    results.add(juce::var(pResult));
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void CorrectnessChecks::checkTremoloBank(juce::Array<juce::var> &results)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numChannels = 2;
+    constexpr int blockSize = 512;
+    constexpr int numBlocks = 200;
+
+    const std::pair<const char *, std::vector<ParameterSetting>> cases[] =
+    {
+        { "defaults",            {} },
+        { "sine spread",         { { "speed", "7" }, { "depth", "0.5" }, { "spread", "90" } } },
+        { "square",              { { "oscillator", "Square" }, { "speed", "13" }, { "gain", "0.75" } } },
+        { "triangle tempo sync", { { "oscillator", "Triangle" }, { "sync", "on" }, { "division", "1/8T" } } },
+        { "bypass",              { { "bypass", "on" } } },
+    };
+
+    // One voice per case, all in the same tile, so the branchless shape
+    // blending gets voices with different shapes side by side.
+    const int numVoices = static_cast<int>(std::size(cases));
+    TremoloBank bank;
+    bank.prepare(sampleRate, numVoices, numChannels);
+    juce::AudioBuffer<float> bankBuffer(numVoices * numChannels, blockSize);
+
+    std::vector<std::unique_ptr<TremoloAudioProcessor>> processors;
+    for (int voice = 0; voice < numVoices; ++voice)
+    {
+        // Parameters first, so prepareToPlay() starts the ramps at them too.
+        processors.push_back(std::make_unique<TremoloAudioProcessor>());
+        TremoloAudioProcessor &processor = *processors.back();
+        setParameters(processor, cases[voice].second);
+        OfflineRenderer::prepareProcessor(processor, sampleRate, numChannels, blockSize);
+
+        // The settings are taken from the processor's parameters rather than
+        // typed in again, since text like "7" doesn't survive the trip
+        // through a normalized float exactly.
+        bank.setVoiceSettings(voice, TremoloBank::VoiceSettings::fromParameters(processor.getAudioParameters()));
+        bank.resetVoice(voice);
+    }
+
+    juce::AudioBuffer<float> input(numChannels, blockSize);
+    juce::AudioBuffer<float> processorBuffer(numChannels, blockSize);
+    juce::MidiBuffer midiMessages;
+    juce::Random random(1);
+    std::vector<double> maxDifferences(static_cast<size_t>(numVoices), 0.0);
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < blockSize; ++i)
+                input.setSample(channel, i, random.nextFloat() - 0.5f);
+        }
+
+        for (int channel = 0; channel < bankBuffer.getNumChannels(); ++channel)
+            bankBuffer.copyFrom(channel, 0, input, channel % numChannels, 0, blockSize);
+        bank.process(bankBuffer.getArrayOfWritePointers(), blockSize);
+
+        for (int voice = 0; voice < numVoices; ++voice)
+        {
+            processorBuffer.makeCopyOf(input, true);
+            processors[static_cast<size_t>(voice)]->processBlock(processorBuffer, midiMessages);
+
+            double &maxDifference = maxDifferences[static_cast<size_t>(voice)];
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const float *pExpected = processorBuffer.getReadPointer(channel);
+                const float *pActual = bankBuffer.getReadPointer(voice * numChannels + channel);
+                for (int i = 0; i < blockSize; ++i)
+                    maxDifference = std::max(maxDifference, std::abs(static_cast<double>(pExpected[i]) - pActual[i]));
+            }
+        }
+    }
+
+    // The bank calculates the sine almost exactly, while the processor reads
+    // it from its table. Both round their output to float on top of that.
+    const double bound = SineKernel::maxAbsoluteError(processors.front()->getSinePrecision()) + 1e-7;
+    for (int voice = 0; voice < numVoices; ++voice)
+    {
+        const double maxDifference = maxDifferences[static_cast<size_t>(voice)];
+        juce::DynamicObject *pResult = makeResult("TremoloBank::process", cases[voice].first, maxDifference < bound);
+        pResult->setProperty("maxDifference", maxDifference);
+        pResult->setProperty("bound", bound);
+        results.add(juce::var(pResult));
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void CorrectnessChecks::checkControlRateLfo(juce::Array<juce::var> &results)
+{
+    constexpr int numChannels = 2;
+    constexpr int blockSize = 512;
+    constexpr int numBlocks = 100;
+
+    const std::pair<const char *, LfoInterpolation> interpolations[] =
+    {
+        { "Linear", LfoInterpolation::Linear },
+        { "Cubic",  LfoInterpolation::Cubic },
+    };
+
+    // The slowest and fastest speeds, at the lowest and a high sample rate.
+    // The spread runs the right channel off a phase of its own.
+    const double sampleRates[] = { 44100.0, 192000.0 };
+    const std::pair<const char *, std::vector<ParameterSetting>> cases[] =
+    {
+        { "1 Hz",          { { "speed", "1" } } },
+        { "40 Hz",         { { "speed", "40" } } },
+        { "13 Hz spread",  { { "speed", "13" }, { "spread", "90" } } },
+    };
+
+    juce::AudioBuffer<float> input(numChannels, blockSize);
+    juce::AudioBuffer<float> expected(numChannels, blockSize);
+    juce::AudioBuffer<float> actual(numChannels, blockSize);
+    juce::MidiBuffer midiMessages;
+
+    for (const auto &interpolation : interpolations)
+    {
+        for (double sampleRate : sampleRates)
+        {
+            for (const auto &testCase : cases)
+            {
+                TremoloAudioProcessor audioRate;
+                TremoloAudioProcessor controlRate;
+                controlRate.setLfoInterpolation(interpolation.second);
+                for (TremoloAudioProcessor *pProcessor : { &audioRate, &controlRate })
+                {
+                    setParameters(*pProcessor, testCase.second);
+                    OfflineRenderer::prepareProcessor(*pProcessor, sampleRate, numChannels, blockSize);
+                }
+
+                juce::Random random(1);
+                double maxDifference = 0.0;
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        for (int i = 0; i < blockSize; ++i)
+                            input.setSample(channel, i, random.nextFloat() - 0.5f);
+                    }
+
+                    expected.makeCopyOf(input, true);
+                    audioRate.processBlock(expected, midiMessages);
+                    actual.makeCopyOf(input, true);
+                    controlRate.processBlock(actual, midiMessages);
+                    maxDifference = std::max(maxDifference, getMaxDifference(expected, actual));
+                }
+
+                // The processor picks the interval the same way. The bound
+                // covers the table's error in the control points, but not
+                // the polynomial's the table was built with, which the cubic
+                // can grow by 1.25. The audio rate values are off from the
+                // true sine by the tier's full error. The shape moves the
+                // gain by at most depth * gain / 2, on input no louder than
+                // 0.5, and both outputs are rounded to float.
+                const SinePrecision precision = controlRate.getSinePrecision();
+                const int tableSize = SineKernel::getTableSize(precision);
+                const double phaseDelta = *controlRate.getAudioParameters().m_pSpeedParamInHz / sampleRate;
+                const int interval = ControlRateLfo::chooseInterval(interpolation.second, phaseDelta, tableSize);
+                const double shapeBound = ControlRateLfo::maxAbsoluteError(interpolation.second, phaseDelta * interval, tableSize)
+                    + 1.25 * SineKernel::maxPolynomialError(precision) + SineKernel::maxAbsoluteError(precision);
+                const double bound = shapeBound * 0.25 + 1e-7;
+
+                const juce::String caseName = juce::String(interpolation.first) + ", " + testCase.first + " at "
+                    + juce::String(sampleRate / 1000.0) + " kHz";
+                juce::DynamicObject *pResult = makeResult("ControlRateLfo::render", caseName, maxDifference < bound);
+                pResult->setProperty("controlInterval", interval);
+                pResult->setProperty("maxDifference", maxDifference);
+                pResult->setProperty("bound", bound);
+                results.add(juce::var(pResult));
+
+                audioRate.releaseResources();
+                controlRate.releaseResources();
+            }
+        }
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void CorrectnessChecks::checkParallelRender(juce::Array<juce::var> &results)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numChannels = 2;
+    constexpr int blockSize = 512;
+
+    // Small tasks on a few threads, so the file is split up plenty and every
+    // task but the first starts with a seek.
+    ParallelRenderer::Options parallelOptions;
+    parallelOptions.blockSize = blockSize;
+    parallelOptions.blocksPerTask = 4;
+    parallelOptions.numThreads = 4;
+
+    OfflineRenderer::Options options;
+    options.chunkSize = blockSize;
+
+    const juce::TemporaryFile input(".wav");
+    const juce::TemporaryFile singleThreadedOutput(".wav");
+    const juce::TemporaryFile parallelOutput(".wav");
+    options.inputFile = input.getFile();
+    writeTestInput(options.inputFile, sampleRate, numChannels, static_cast<int>(sampleRate * 3));
+
+    // Bypass isn't part of the processor's state, so it's the one most
+    // likely to get lost on the way to the workers.
+    const std::pair<const char *, std::vector<ParameterSetting>> cases[] =
+    {
+        { "defaults",      {} },
+        { "bypass",        { { "bypass", "on" } } },
+        { "square spread", { { "oscillator", "Square" }, { "spread", "90" }, { "speed", "7" } } },
+        { "tempo sync",    { { "sync", "on" }, { "division", "1/8" } } },
+    };
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    for (const auto &testCase : cases)
+    {
+        TremoloAudioProcessor processor;
+        setParameters(processor, testCase.second);
+        options.outputFile = singleThreadedOutput.getFile();
+        OfflineRenderer(processor).render(options);
+
+        ParallelRenderer renderer([&testCase](TremoloAudioProcessor &workerProcessor)
+        {
+            setParameters(workerProcessor, testCase.second);
+        });
+        renderer.render({ { options.inputFile, parallelOutput.getFile() } }, parallelOptions);
+
+        const juce::AudioBuffer<float> expected = readWholeFile(formatManager, singleThreadedOutput.getFile());
+        const juce::AudioBuffer<float> actual = readWholeFile(formatManager, parallelOutput.getFile());
+        const bool isSameSize = (expected.getNumChannels() == actual.getNumChannels())
+                             && (expected.getNumSamples() == actual.getNumSamples());
+        const double maxDifference = isSameSize ? getMaxDifference(expected, actual) : 0.0;
+
+        juce::DynamicObject *pResult = makeResult("ParallelRenderer::render", testCase.first, isSameSize && maxDifference == 0.0);
+        pResult->setProperty("isSameSize", isSameSize);
+        pResult->setProperty("maxDifference", maxDifference);
+        results.add(juce::var(pResult));
+    }
+}
@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+
+/**
+ * Checks that the fast paths still give the right answers: that a parallel
+ * render matches a single threaded one, and so on. Each check comes out as
+ * a JSON object with a "passed" flag next to what was measured, so a script
+ * can fail a build on them.
+ *
+ * Run them with SKTremoloBench --check.
+ *
+ * @since 2026 Oct 16
+ */
+class CorrectnessChecks
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param filter Only checks whose name contains this run. Empty runs them all.
+     */
+    explicit CorrectnessChecks(const juce::String &filter);
+
+    /**
+     * Runs every check that passes the filter.
+     *
+     * @param onProgress Called with the name of every check as it starts. May be empty.
+     * @return One JSON object per check and case.
+     */
+    juce::Array<juce::var> run(const std::function<void(const juce::String &)> &onProgress);
+
+    /**
+     * Returns true if every result run() returned passed.
+     */
+    static bool allPassed(const juce::Array<juce::var> &results);
+
+private:
+
+    /**
+     * Sweeps every phase in [0, 1) in steps of 1e-7 through each SineKernel
+     * precision tier and checks the error against std::cos stays within the
+     * bound the tier promises, both straight from the polynomial and read
+     * back from the tier's EnvelopeTable.
+     */
+    void checkSinePrecision(juce::Array<juce::var> &results);
+
+    /**
+     * Advances a PhaseAccumulator 10^11 samples in big jumps, for a few
+     * frequencies and sample rates that have an exact rational phase, and
+     * checks it never drifts further from that phase than the rounding of
+     * its increment allows. Also checks setPhase() wraps phases that round
+     * up to 1.0.
+     */
+    void checkPhaseAccumulator(juce::Array<juce::var> &results);
+
+    /**
+     * Runs the same input through a TremoloAudioProcessor and a TremoloBank
+     * voice with the same settings, for a handful of settings at once (one
+     * voice each), and checks the outputs agree to within the accuracy of
+     * the processor's sine table.
+     */
+    void checkTremoloBank(juce::Array<juce::var> &results);
+
+    /**
+     * Runs the same input through a TremoloAudioProcessor with a control rate
+     * sine and one with an audio rate sine, for both interpolations at a few
+     * speeds and sample rates, and checks the outputs agree to within
+     * ControlRateLfo::maxAbsoluteError().
+     */
+    void checkControlRateLfo(juce::Array<juce::var> &results);
+
+    /**
+     * Renders the same file with OfflineRenderer and ParallelRenderer, for a
+     * handful of parameter settings, and checks the outputs are bit for bit
+     * the same.
+     */
+    void checkParallelRender(juce::Array<juce::var> &results);
+
+    const juce::String m_filter; //!< Only checks whose name contains this run.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CorrectnessChecks)
+};
@@ -0,0 +1,441 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "bench/DspBenchmarks.h"
+#include "bench/BenchmarkTimer.h"
+#include "dsp/TremoloAudioProcessor.h"
+#include "render/OfflineRenderer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+    //! The speed every oscillator runs at. It makes no difference to the timing.
+    constexpr double SPEED_IN_HZ = 5.0;
+
+    //! The wave shapes, in the same order as the oscillator parameter's choices.
+    const char *const WAVEFORM_NAMES[] = { "Sine", "Square", "Triangle" };
+
+    //! The per-sample wave shape functions, in the same order as WAVEFORM_NAMES.
+    const WaveShapes::ShapeFunction SHAPE_FUNCTIONS[] = { &WaveShapes::sine, &WaveShapes::square, &WaveShapes::triangle };
+
+    //! Results are written here so the compiler can't throw the work away.
+    volatile double g_sink = 0.0;
+
+    /**
+     * Turns one measurement into a JSON object. Sweep dimensions that don't
+     * apply to a benchmark are left out.
+     */
+    juce::var makeResult(const juce::String &name, const char *pWaveform, int blockSize, int numChannels,
+        double sampleRate, const BenchmarkTimer::Measurement &measurement)
+    {
+        auto *pResult = new juce::DynamicObject();
+        pResult->setProperty("benchmark", name);
+        if (pWaveform)
+            pResult->setProperty("waveform", pWaveform);
+        if (blockSize > 0)
+            pResult->setProperty("blockSize", blockSize);
+        if (numChannels > 0)
+            pResult->setProperty("numChannels", numChannels);
+        if (sampleRate > 0.0)
+            pResult->setProperty("sampleRate", sampleRate);
+        pResult->setProperty("nsPerSample", measurement.nsPerSample);
+        pResult->setProperty("cyclesPerSample", (measurement.cyclesPerSample >= 0.0) ? juce::var(measurement.cyclesPerSample) : juce::var());
+        return juce::var(pResult);
+    }
+
+    /**
+     * Sets a processor parameter by ID from text, the way a user would type it in.
+     */
+    void setParameter(juce::AudioProcessor &processor, const juce::String &parameterID, const juce::String &text)
+    {
+        for (juce::AudioProcessorParameter *pParameter : processor.getParameters())
+        {
+            auto *pRangedParameter = dynamic_cast<juce::RangedAudioParameter *>(pParameter);
+            if (pRangedParameter && pRangedParameter->getParameterID() == parameterID)
+                pRangedParameter->setValueNotifyingHost(pRangedParameter->getValueForText(text));
+        }
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+DspBenchmarks::Options DspBenchmarks::Options::full()
+{
+    Options options;
+    for (int blockSize = 1; blockSize <= 8192; blockSize *= 2)
+        options.blockSizes.push_back(blockSize);
+    options.channelCounts = { 1, 2, 4, 8, 16 };
+    options.sampleRates = { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0, 384000.0 };
+    return options;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+DspBenchmarks::Options DspBenchmarks::Options::quick()
+{
+    Options options;
+    options.blockSizes = { 1, 64, 512, 8192 };
+    options.channelCounts = { 1, 2 };
+    options.sampleRates = { 48000.0 };
+    options.minSeconds = 0.005;
+    return options;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+DspBenchmarks::DspBenchmarks(const Options &options)
+    : m_options(options)
+{
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+juce::Array<juce::var> DspBenchmarks::run(const std::function<void(const juce::String &)> &onProgress)
+{
+    const juce::ScopedNoDenormals noDenormals;
+
+    struct Benchmark
+    {
+        const char *pName;
+        void (DspBenchmarks::*pRun)(juce::Array<juce::var> &);
+    };
+
+    const Benchmark benchmarks[] =
+    {
+        { "PhaseAccumulator::nextValue",                             &DspBenchmarks::runOscillatorNextValue },
+        { "PhaseAccumulator::skipNextValue",                         &DspBenchmarks::runOscillatorSkip },
+        { "TremoloKernels::shapeRenderer",                           &DspBenchmarks::runShapeRenderer },
+        { "TremoloAudioProcessor::calculateTremoloEffectValue",      &DspBenchmarks::runEffectValue },
+        { "TremoloAudioProcessor::processBlock",                     &DspBenchmarks::runProcessBlock },
+        { "TremoloAudioProcessor::processBlock (LFO interpolation)", &DspBenchmarks::runLfoInterpolation },
+    };
+
+    juce::Array<juce::var> results;
+    for (const Benchmark &benchmark : benchmarks)
+    {
+        if (m_options.filter.isNotEmpty() && !juce::String(benchmark.pName).containsIgnoreCase(m_options.filter))
+            continue;
+
+        if (onProgress)
+            onProgress(benchmark.pName);
+        (this->*benchmark.pRun)(results);
+    }
+
+    return results;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void DspBenchmarks::runOscillatorNextValue(juce::Array<juce::var> &results)
+{
+    // The oscillators' old nextValue(): one shape value per sample, straight
+    // off the phase accumulator.
+    const BenchmarkTimer timer(m_options.minSeconds);
+
+    for (size_t shapeIndex = 0; shapeIndex < std::size(SHAPE_FUNCTIONS); ++shapeIndex)
+    {
+        const WaveShapes::ShapeFunction shape = SHAPE_FUNCTIONS[shapeIndex];
+
+        for (double sampleRate : m_options.sampleRates)
+        {
+            PhaseAccumulator phase;
+            phase.setSampleRate(sampleRate);
+            phase.setFrequency(SPEED_IN_HZ);
+
+            for (int blockSize : m_options.blockSizes)
+            {
+                const auto measurement = timer.measure(blockSize, [&]
+                {
+                    double sum = 0.0;
+                    for (int i = 0; i < blockSize; ++i)
+                    {
+                        sum += shape(phase.getPhase());
+                        phase.advance(1);
+                    }
+                    g_sink = sum;
+                });
+
+                results.add(makeResult("PhaseAccumulator::nextValue", WAVEFORM_NAMES[shapeIndex], blockSize, 0,
+                    sampleRate, measurement));
+            }
+        }
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void DspBenchmarks::runOscillatorSkip(juce::Array<juce::var> &results)
+{
+    // The oscillators' old skipNextValue(), a whole block at a time. It's the
+    // same for every wave shape, since they all share the one phase.
+    const BenchmarkTimer timer(m_options.minSeconds);
+
+    for (double sampleRate : m_options.sampleRates)
+    {
+        PhaseAccumulator phase;
+        phase.setSampleRate(sampleRate);
+        phase.setFrequency(SPEED_IN_HZ);
+
+        for (int blockSize : m_options.blockSizes)
+        {
+            const auto measurement = timer.measure(blockSize, [&]
+            {
+                phase.advance(blockSize);
+                g_sink = phase.getPhase();
+            });
+
+            results.add(makeResult("PhaseAccumulator::skipNextValue", nullptr, blockSize, 0, sampleRate, measurement));
+        }
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void DspBenchmarks::runShapeRenderer(juce::Array<juce::var> &results)
+{
+    const BenchmarkTimer timer(m_options.minSeconds);
+    const InstructionSet instructionSet = InstructionSets::select();
+
+    EnvelopeTable sineTable;
+    sineTable.build(SineKernel::getBlockRenderer(SinePrecision::Standard), SineKernel::getTableSize(SinePrecision::Standard));
+
+    const int maxBlockSize = *std::max_element(m_options.blockSizes.begin(), m_options.blockSizes.end());
+    std::vector<double> values(static_cast<size_t>(maxBlockSize));
+
+    for (size_t shapeIndex = 0; shapeIndex < std::size(WAVEFORM_NAMES); ++shapeIndex)
+    {
+        const TremoloKernels::ShapeRenderFunction renderShape = TremoloKernels::getShapeRenderer(instructionSet, shapeIndex);
+
+        for (double sampleRate : m_options.sampleRates)
+        {
+            PhaseAccumulator phase;
+            phase.setSampleRate(sampleRate);
+            phase.setFrequency(SPEED_IN_HZ);
+
+            for (int blockSize : m_options.blockSizes)
+            {
+                const auto measurement = timer.measure(blockSize, [&]
+                {
+                    renderShape(sineTable, phase.getPhase(), phase.getPhaseDelta(), values.data(), blockSize);
+                    phase.advance(blockSize);
+                    g_sink = values[0];
+                });
+
+                results.add(makeResult("TremoloKernels::shapeRenderer", WAVEFORM_NAMES[shapeIndex], blockSize, 0,
+                    sampleRate, measurement));
+            }
+        }
+    }
+
+    // The polynomial the table was built from, evaluated for every sample
+    // instead of being read back.
+    const std::pair<const char *, SinePrecision> tiers[] =
+    {
+        { "Fast", SinePrecision::Fast },
+        { "Standard", SinePrecision::Standard },
+        { "High", SinePrecision::High },
+    };
+
+    for (const auto &tier : tiers)
+    {
+        const WaveShapes::BlockRenderFunction renderBlock = SineKernel::getBlockRenderer(tier.second);
+        const juce::String name = juce::String("SineKernel::renderBlock (") + tier.first + ")";
+
+        for (double sampleRate : m_options.sampleRates)
+        {
+            PhaseAccumulator phase;
+            phase.setSampleRate(sampleRate);
+            phase.setFrequency(SPEED_IN_HZ);
+
+            for (int blockSize : m_options.blockSizes)
+            {
+                const auto measurement = timer.measure(blockSize, [&]
+                {
+                    renderBlock(phase.getPhase(), phase.getPhaseDelta(), values.data(), blockSize);
+                    phase.advance(blockSize);
+                    g_sink = values[0];
+                });
+
+                results.add(makeResult(name, "Sine", blockSize, 0, sampleRate, measurement));
+            }
+        }
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void DspBenchmarks::runEffectValue(juce::Array<juce::var> &results)
+{
+    // Doesn't depend on the wave shape or sample rate. Only the block size
+    // matters, through the loop overhead.
+    const BenchmarkTimer timer(m_options.minSeconds);
+
+    const int maxBlockSize = *std::max_element(m_options.blockSizes.begin(), m_options.blockSizes.end());
+    std::vector<double> values(static_cast<size_t>(maxBlockSize));
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = WaveShapes::sine(static_cast<double>(i) / values.size());
+
+    for (int blockSize : m_options.blockSizes)
+    {
+        const auto measurement = timer.measure(blockSize, [&]
+        {
+            double sum = 0.0;
+            for (int i = 0; i < blockSize; ++i)
+                sum += TremoloAudioProcessor::calculateTremoloEffectValue(values[static_cast<size_t>(i)], 0.8, 0.9, 0.0);
+            g_sink = sum;
+        });
+
+        results.add(makeResult("TremoloAudioProcessor::calculateTremoloEffectValue", nullptr, blockSize, 0, 0.0,
+            measurement));
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void DspBenchmarks::runProcessBlock(juce::Array<juce::var> &results)
+{
+    const BenchmarkTimer timer(m_options.minSeconds);
+    const int maxBlockSize = *std::max_element(m_options.blockSizes.begin(), m_options.blockSizes.end());
+    juce::MidiBuffer midiMessages;
+
+    for (int numChannels : m_options.channelCounts)
+    {
+        // The processor works in place, and a tremolo keeps turning the level
+        // down. Every run starts from a fresh copy of the input, so the audio
+        // never fades into silence (or denormals). The copy is timed on its
+        // own and taken back out.
+        juce::AudioBuffer<float> input(numChannels, maxBlockSize);
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::fill(input.getWritePointer(channel), 0.5f, maxBlockSize);
+        juce::AudioBuffer<float> work(numChannels, maxBlockSize);
+
+        for (double sampleRate : m_options.sampleRates)
+        {
+            TremoloAudioProcessor processor;
+            setParameter(processor, "speed", juce::String(SPEED_IN_HZ));
+            OfflineRenderer::prepareProcessor(processor, sampleRate, numChannels, maxBlockSize);
+
+            for (const char *pWaveform : WAVEFORM_NAMES)
+            {
+                setParameter(processor, "oscillator", pWaveform);
+
+                for (int blockSize : m_options.blockSizes)
+                {
+                    juce::AudioBuffer<float> block(work.getArrayOfWritePointers(), numChannels, blockSize);
+                    const auto copyInput = [&]
+                    {
+                        for (int channel = 0; channel < numChannels; ++channel)
+                            juce::FloatVectorOperations::copy(block.getWritePointer(channel), input.getReadPointer(channel), blockSize);
+                    };
+
+                    const auto copyOnly = timer.measure(blockSize, [&]
+                    {
+                        copyInput();
+                        g_sink = block.getSample(0, 0);
+                    });
+
+                    auto measurement = timer.measure(blockSize, [&]
+                    {
+                        copyInput();
+                        processor.processBlock(block, midiMessages);
+                        g_sink = block.getSample(0, 0);
+                    });
+
+                    measurement.nsPerSample = std::max(measurement.nsPerSample - copyOnly.nsPerSample, 0.0);
+                    if (measurement.cyclesPerSample >= 0.0)
+                        measurement.cyclesPerSample = std::max(measurement.cyclesPerSample - copyOnly.cyclesPerSample, 0.0);
+
+                    results.add(makeResult("TremoloAudioProcessor::processBlock", pWaveform, blockSize, numChannels,
+                        sampleRate, measurement));
+                }
+            }
+
+            processor.releaseResources();
+        }
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void DspBenchmarks::runLfoInterpolation(juce::Array<juce::var> &results)
+{
+    // Control rate only pays off at high sample rates, so this always sweeps
+    // all of them, whatever the options say. Stereo, like most tracks.
+    constexpr int numChannels = 2;
+    const double sampleRates[] = { 44100.0, 48000.0, 96000.0, 192000.0, 384000.0 };
+    const std::pair<const char *, LfoInterpolation> interpolations[] =
+    {
+        { "None",   LfoInterpolation::None },
+        { "Linear", LfoInterpolation::Linear },
+        { "Cubic",  LfoInterpolation::Cubic },
+    };
+
+    const BenchmarkTimer timer(m_options.minSeconds);
+    const int maxBlockSize = *std::max_element(m_options.blockSizes.begin(), m_options.blockSizes.end());
+    juce::MidiBuffer midiMessages;
+
+    // Fresh input for every run, as in runProcessBlock().
+    juce::AudioBuffer<float> input(numChannels, maxBlockSize);
+    for (int channel = 0; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::fill(input.getWritePointer(channel), 0.5f, maxBlockSize);
+    juce::AudioBuffer<float> work(numChannels, maxBlockSize);
+
+    for (double sampleRate : sampleRates)
+    {
+        for (const auto &interpolation : interpolations)
+        {
+            TremoloAudioProcessor processor;
+            processor.setLfoInterpolation(interpolation.second);
+            setParameter(processor, "speed", juce::String(SPEED_IN_HZ));
+            OfflineRenderer::prepareProcessor(processor, sampleRate, numChannels, maxBlockSize);
+
+            for (int blockSize : m_options.blockSizes)
+            {
+                juce::AudioBuffer<float> block(work.getArrayOfWritePointers(), numChannels, blockSize);
+                const auto copyInput = [&]
+                {
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        juce::FloatVectorOperations::copy(block.getWritePointer(channel), input.getReadPointer(channel), blockSize);
+                };
+
+                const auto copyOnly = timer.measure(blockSize, [&]
+                {
+                    copyInput();
+                    g_sink = block.getSample(0, 0);
+                });
+
+                auto measurement = timer.measure(blockSize, [&]
+                {
+                    copyInput();
+                    processor.processBlock(block, midiMessages);
+                    g_sink = block.getSample(0, 0);
+                });
+
+                measurement.nsPerSample = std::max(measurement.nsPerSample - copyOnly.nsPerSample, 0.0);
+                if (measurement.cyclesPerSample >= 0.0)
+                    measurement.cyclesPerSample = std::max(measurement.cyclesPerSample - copyOnly.cyclesPerSample, 0.0);
+
+                juce::var result = makeResult("TremoloAudioProcessor::processBlock (LFO interpolation)", "Sine", blockSize,
+                    numChannels, sampleRate, measurement);
+                result.getDynamicObject()->setProperty("lfoInterpolation", interpolation.first);
+                results.add(result);
+            }
+
+            processor.releaseResources();
+        }
+    }
+}
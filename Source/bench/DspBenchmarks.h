@@ -0,0 +1,104 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+/**
+ * Microbenchmarks for the DSP code, from the oscillator on up to a full
+ * TremoloAudioProcessor::processBlock(). Each benchmark is swept across
+ * wave shapes, block sizes, channel counts, and sample rates, as far as
+ * they make a difference to it.
+ *
+ * Results come out as JSON so builds can be compared with a script. See
+ * SKTremoloBench's Main.cpp for the layout.
+ *
+ * @since 2026 Oct 16
+ */
+class DspBenchmarks
+{
+public:
+
+    /**
+     * What to run and for how long.
+     */
+    struct Options
+    {
+        std::vector<int> blockSizes;     //!< Samples per block.
+        std::vector<int> channelCounts;  //!< Channels per block. Only processBlock() cares.
+        std::vector<double> sampleRates; //!< Sample rates in Hz.
+        juce::String filter;             //!< Only benchmarks whose name contains this run. Empty runs them all.
+        double minSeconds = 0.02;        //!< How long each measurement takes, at least.
+
+        /**
+         * Returns the full sweep: every power of two from 1 to 8192 samples,
+         * 1 to 16 channels, and the common sample rates from 44.1 to 384 kHz.
+         */
+        static Options full();
+
+        /**
+         * Returns a sweep that takes seconds rather than minutes, for a
+         * quick sanity check.
+         */
+        static Options quick();
+    };
+
+    /**
+     * Constructor.
+     */
+    explicit DspBenchmarks(const Options &options);
+
+    /**
+     * Runs every benchmark that passes the filter.
+     *
+     * @param onProgress Called with the name of every benchmark as it starts. May be empty.
+     * @return One JSON object per measurement.
+     */
+    juce::Array<juce::var> run(const std::function<void(const juce::String &)> &onProgress);
+
+private:
+
+    /**
+     * Times one shape value per sample off a PhaseAccumulator, for every wave
+     * shape. That's what the per-waveform oscillators' nextValue() used to do.
+     */
+    void runOscillatorNextValue(juce::Array<juce::var> &results);
+
+    /**
+     * Times skipping a whole block, which is what the oscillators'
+     * skipNextValue() became.
+     */
+    void runOscillatorSkip(juce::Array<juce::var> &results);
+
+    /**
+     * Times the block shape renderers the processor uses, for every wave shape.
+     * The sine renderer reads an EnvelopeTable, so every SineKernel tier's
+     * polynomial is timed on its own too, to compare the two.
+     */
+    void runShapeRenderer(juce::Array<juce::var> &results);
+
+    /**
+     * Times TremoloAudioProcessor::calculateTremoloEffectValue().
+     */
+    void runEffectValue(juce::Array<juce::var> &results);
+
+    /**
+     * Times TremoloAudioProcessor::processBlock() across the whole sweep.
+     */
+    void runProcessBlock(juce::Array<juce::var> &results);
+
+    /**
+     * Times TremoloAudioProcessor::processBlock() with the sine shape at
+     * audio rate and at control rate with each interpolation, at every
+     * common sample rate from 44.1 to 384 kHz. See ControlRateLfo.
+     */
+    void runLfoInterpolation(juce::Array<juce::var> &results);
+
+    const Options m_options; //!< What to run and for how long.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspBenchmarks)
+};
@@ -0,0 +1,177 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "bench/CorrectnessChecks.h"
+#include "bench/DspBenchmarks.h"
+#include "bench/BenchmarkTimer.h"
+#include "bench/ScalingBenchmark.h"
+#include "dsp/InstructionSet.h"
+#include "common/Trace.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * Prints how to use the benchmark tool.
+     */
+    void printUsage()
+    {
+        std::cout
+            << "Usage: SKTremoloBench [options]\n"
+            << "\n"
+            << "Times the SKTremolo DSP code and prints the results as JSON.\n"
+            << "\n"
+            << "Options:\n"
+            << "  --output=<file>     Writes the JSON to a file instead of the console.\n"
+            << "  --quick             Runs a small sweep that takes seconds, not minutes.\n"
+            << "  --filter=<text>     Only runs benchmarks whose name contains the text.\n"
+            << "  --min-time=<ms>     How long each measurement takes, at least.\n"
+            << "  --trace=<file>      Writes a Chrome trace of the run. Needs a build with TREMOLO_TRACE=1.\n"
+            << "\n"
+            << "  --check             Runs the correctness checks instead. Exits with 1 if any fail.\n"
+            << "                      Takes --filter too.\n"
+            << "\n"
+            << "  --scaling           Runs many processors, then as many TremoloBank streams,\n"
+            << "                      on 1 to 64 threads instead, to see how throughput scales\n"
+            << "                      with cores.\n"
+            << "  --instances=<count> The number of processors and streams for --scaling.\n"
+            << "                      Defaults to 512.\n"
+            << "  --max-threads=<n>   The most threads for --scaling. Defaults to the number\n"
+            << "                      of cores, up to 64.\n"
+            << "\n"
+            << "Set " << InstructionSets::OVERRIDE_ENV_VAR << " to generic, sse42, avx2, or avx512 to compare kernels.\n";
+    }
+
+    /**
+     * Describes the machine and build the results came from, so results
+     * from different runs can be told apart.
+     */
+    juce::var describeEnvironment()
+    {
+        auto *pEnvironment = new juce::DynamicObject();
+        pEnvironment->setProperty("cpu", juce::SystemStats::getCpuModel());
+        pEnvironment->setProperty("numCpus", juce::SystemStats::getNumCpus());
+        pEnvironment->setProperty("cpuSpeedMHz", juce::SystemStats::getCpuSpeedInMegahertz());
+        pEnvironment->setProperty("os", juce::SystemStats::getOperatingSystemName());
+        pEnvironment->setProperty("instructionSet", InstructionSets::getName(InstructionSets::select()));
+        pEnvironment->setProperty("juceVersion", juce::SystemStats::getJUCEVersion());
+        pEnvironment->setProperty("buildDate", __DATE__ " " __TIME__);
+       #if JUCE_DEBUG
+        pEnvironment->setProperty("debug", true);
+       #else
+        pEnvironment->setProperty("debug", false);
+       #endif
+        pEnvironment->setProperty("hasCycleCounter", BenchmarkTimer::hasTimeStampCounter());
+        pEnvironment->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+        return juce::var(pEnvironment);
+    }
+}
+
+/**
+ * The entry point of the benchmark tool.
+ *
+ * @since 2026 Oct 16
+ */
+int main(int argc, char *argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    try
+    {
+        if (args.containsOption("--trace") && !TREMOLO_TRACE)
+            throw std::runtime_error("This build can't trace. Build it with TREMOLO_TRACE=1.");
+        TREMOLO_TRACE_PREPARE_THREAD();
+
+        // Progress goes to stderr, so stdout is nothing but JSON.
+        juce::Array<juce::var> results;
+        if (args.containsOption("--check"))
+        {
+            CorrectnessChecks checks(args.getValueForOption("--filter"));
+            results = checks.run([](const juce::String &name)
+            {
+                std::cerr << "Checking " << name << "...\n";
+            });
+        }
+        else if (args.containsOption("--scaling"))
+        {
+            ScalingBenchmark::Options options;
+            options.maxThreads = std::min(juce::SystemStats::getNumCpus(), 64);
+            if (args.containsOption("--instances"))
+                options.numInstances = args.getValueForOption("--instances").getIntValue();
+            if (args.containsOption("--max-threads"))
+                options.maxThreads = args.getValueForOption("--max-threads").getIntValue();
+            if (args.containsOption("--min-time"))
+                options.secondsPerThreadCount = args.getValueForOption("--min-time").getDoubleValue() / 1000.0;
+
+            ScalingBenchmark benchmark(options);
+            results = benchmark.run([](const juce::String &name, int numThreads)
+            {
+                std::cerr << "Running " << name << " on " << numThreads << " threads...\n";
+            });
+        }
+        else
+        {
+            DspBenchmarks::Options options = args.containsOption("--quick") ? DspBenchmarks::Options::quick()
+                                                                             : DspBenchmarks::Options::full();
+            if (args.containsOption("--filter"))
+                options.filter = args.getValueForOption("--filter");
+            if (args.containsOption("--min-time"))
+                options.minSeconds = args.getValueForOption("--min-time").getDoubleValue() / 1000.0;
+
+            DspBenchmarks benchmarks(options);
+            results = benchmarks.run([](const juce::String &name)
+            {
+                std::cerr << "Running " << name << "...\n";
+            });
+        }
+
+        auto *pReport = new juce::DynamicObject();
+        pReport->setProperty("environment", describeEnvironment());
+        pReport->setProperty("results", results);
+        const juce::String json = juce::JSON::toString(juce::var(pReport));
+
+        if (args.containsOption("--output"))
+        {
+            const juce::File outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output"));
+            if (!outputFile.replaceWithText(json))
+                throw std::runtime_error("Couldn't write " + outputFile.getFullPathName().toStdString());
+        }
+        else
+        {
+            std::cout << json << "\n";
+        }
+
+#if TREMOLO_TRACE
+        if (args.containsOption("--trace"))
+        {
+            const juce::File traceFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--trace"));
+            if (!Trace::writeChromeJson(traceFile))
+                throw std::runtime_error("Couldn't write " + traceFile.getFullPathName().toStdString());
+        }
+#endif
+
+        if (args.containsOption("--check") && !CorrectnessChecks::allPassed(results))
+        {
+            std::cerr << "Some checks failed.\n";
+            return 1;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
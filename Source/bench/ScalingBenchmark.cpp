@@ -0,0 +1,268 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "bench/ScalingBenchmark.h"
+#include "dsp/TremoloAudioProcessor.h"
+#include "dsp/TremoloBank.h"
+#include "render/OfflineRenderer.h"
+#include "common/Trace.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * One plugin instance and the buffer its host hands it. Both are
+     * allocated on their own, like a host would.
+     */
+    struct Instance
+    {
+        std::unique_ptr<TremoloAudioProcessor> spProcessor; //!< The plugin.
+        std::unique_ptr<juce::AudioBuffer<float>> spBuffer; //!< The audio it processes in place.
+    };
+
+    /**
+     * One thread's share of the streams for the bank run: a bank of its own
+     * and the streams it processes.
+     */
+    struct BankShare
+    {
+        std::unique_ptr<TremoloBank> spBank;                 //!< The bank. Banks aren't thread-safe, so every thread has one.
+        std::unique_ptr<juce::AudioBuffer<float>> spBuffer; //!< Every channel of every stream, one after the other.
+    };
+
+    /**
+     * Runs a worker on every thread for about the given time, all starting
+     * together, and returns how many blocks they processed per second in
+     * total.
+     *
+     * @param runWorker Called on each thread with the thread's index. Processes
+     *        blocks until stop is set and returns how many it processed.
+     */
+    double measureBlocksPerSecond(int numThreads, double seconds,
+        const std::function<juce::int64(int thread, const std::atomic<bool> &stop)> &runWorker)
+    {
+        std::atomic<int> numReady{ 0 };
+        std::atomic<bool> go{ false };
+        std::atomic<bool> stop{ false };
+        std::vector<juce::int64> blocksProcessed(static_cast<size_t>(numThreads));
+
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < numThreads; ++thread)
+        {
+            threads.emplace_back([&, thread]()
+            {
+                const juce::ScopedNoDenormals noDenormals;
+                TREMOLO_TRACE_PREPARE_THREAD();
+                ++numReady;
+                while (!go)
+                    std::this_thread::yield();
+
+                blocksProcessed[static_cast<size_t>(thread)] = runWorker(thread, stop);
+            });
+        }
+
+        while (numReady < numThreads)
+            std::this_thread::yield();
+
+        const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+        go = true;
+        juce::Thread::sleep(static_cast<int>(seconds * 1000.0));
+        stop = true;
+
+        for (std::thread &thread : threads)
+            thread.join();
+        const double elapsedSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+        juce::int64 totalBlocks = 0;
+        for (juce::int64 numBlocks : blocksProcessed)
+            totalBlocks += numBlocks;
+        return static_cast<double>(totalBlocks) / elapsedSeconds;
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+ScalingBenchmark::ScalingBenchmark(const Options &options)
+    : m_options(options)
+{
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+juce::Array<juce::var> ScalingBenchmark::run(const std::function<void(const juce::String &name, int numThreads)> &onProgress)
+{
+    juce::Array<juce::var> results;
+    runProcessors(results, onProgress);
+    runBank(results, onProgress);
+    return results;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+juce::AudioBuffer<float> ScalingBenchmark::makeInput() const
+{
+    // The tremolo keeps turning the level down, so every block starts from a
+    // fresh copy of the input. Otherwise the audio would fade into silence
+    // and we'd be timing the silence skip. Hosts copy audio around too.
+    juce::AudioBuffer<float> input(m_options.numChannels, m_options.blockSize);
+    for (int channel = 0; channel < m_options.numChannels; ++channel)
+        juce::FloatVectorOperations::fill(input.getWritePointer(channel), 0.5f, m_options.blockSize);
+    return input;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+std::vector<int> ScalingBenchmark::getThreadCounts() const
+{
+    std::vector<int> threadCounts;
+    for (int numThreads = 1; numThreads <= m_options.maxThreads; numThreads *= 2)
+        threadCounts.push_back(numThreads);
+
+    // Often the number of cores, which is the count that matters most.
+    if (!threadCounts.empty() && threadCounts.back() != m_options.maxThreads)
+        threadCounts.push_back(m_options.maxThreads);
+    return threadCounts;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+juce::var ScalingBenchmark::makeResult(const juce::String &name, int numThreads, double samplesPerSecond,
+    double singleThreadSamplesPerSecond) const
+{
+    const double speedup = (singleThreadSamplesPerSecond > 0.0) ? samplesPerSecond / singleThreadSamplesPerSecond : 0.0;
+
+    auto *pResult = new juce::DynamicObject();
+    pResult->setProperty("benchmark", name);
+    pResult->setProperty("numInstances", m_options.numInstances);
+    pResult->setProperty("numThreads", numThreads);
+    pResult->setProperty("blockSize", m_options.blockSize);
+    pResult->setProperty("numChannels", m_options.numChannels);
+    pResult->setProperty("sampleRate", m_options.sampleRate);
+    pResult->setProperty("samplesPerSecond", samplesPerSecond);
+    pResult->setProperty("nsPerSample", numThreads * 1e9 / samplesPerSecond);
+    pResult->setProperty("streamsPerCore", samplesPerSecond / m_options.sampleRate / numThreads);
+    pResult->setProperty("speedup", speedup);
+    pResult->setProperty("efficiency", speedup / numThreads);
+    pResult->setProperty("oversubscribed", numThreads > juce::SystemStats::getNumCpus());
+    return juce::var(pResult);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void ScalingBenchmark::runProcessors(juce::Array<juce::var> &results,
+    const std::function<void(const juce::String &name, int numThreads)> &onProgress)
+{
+    const juce::String name = "TremoloAudioProcessor::processBlock (many instances)";
+    const int numChannels = m_options.numChannels;
+    const int blockSize = m_options.blockSize;
+    const juce::AudioBuffer<float> input = makeInput();
+
+    std::vector<Instance> instances(static_cast<size_t>(m_options.numInstances));
+    for (Instance &instance : instances)
+    {
+        instance.spProcessor = std::make_unique<TremoloAudioProcessor>();
+        instance.spBuffer = std::make_unique<juce::AudioBuffer<float>>(numChannels, blockSize);
+        OfflineRenderer::prepareProcessor(*instance.spProcessor, m_options.sampleRate, numChannels, blockSize);
+    }
+
+    double singleThreadSamplesPerSecond = 0.0;
+    for (int numThreads : getThreadCounts())
+    {
+        if (onProgress)
+            onProgress(name, numThreads);
+
+        // Every thread takes every numThreads-th instance, until told to stop.
+        const double blocksPerSecond = measureBlocksPerSecond(numThreads, m_options.secondsPerThreadCount,
+            [&](int thread, const std::atomic<bool> &stop)
+        {
+            juce::MidiBuffer midiMessages;
+            juce::int64 numBlocks = 0;
+
+            while (!stop)
+            {
+                for (size_t i = static_cast<size_t>(thread); i < instances.size(); i += static_cast<size_t>(numThreads))
+                {
+                    juce::AudioBuffer<float> &buffer = *instances[i].spBuffer;
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        buffer.copyFrom(channel, 0, input, channel, 0, blockSize);
+
+                    instances[i].spProcessor->processBlock(buffer, midiMessages);
+                    ++numBlocks;
+                }
+            }
+
+            return numBlocks;
+        });
+
+        const double samplesPerSecond = blocksPerSecond * blockSize;
+        if (numThreads == 1)
+            singleThreadSamplesPerSecond = samplesPerSecond;
+        results.add(makeResult(name, numThreads, samplesPerSecond, singleThreadSamplesPerSecond));
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void ScalingBenchmark::runBank(juce::Array<juce::var> &results,
+    const std::function<void(const juce::String &name, int numThreads)> &onProgress)
+{
+    const juce::String name = "TremoloBank::process (many streams)";
+    const int numChannels = m_options.numChannels;
+    const int blockSize = m_options.blockSize;
+    const juce::AudioBuffer<float> input = makeInput();
+
+    double singleThreadSamplesPerSecond = 0.0;
+    for (int numThreads : getThreadCounts())
+    {
+        if (onProgress)
+            onProgress(name, numThreads);
+
+        // The streams are shared out as evenly as they go, one bank per
+        // thread. A server would do the same.
+        std::vector<BankShare> shares(static_cast<size_t>(numThreads));
+        for (int thread = 0; thread < numThreads; ++thread)
+        {
+            const int numStreams = m_options.numInstances / numThreads + ((thread < m_options.numInstances % numThreads) ? 1 : 0);
+            BankShare &share = shares[static_cast<size_t>(thread)];
+            share.spBank = std::make_unique<TremoloBank>();
+            share.spBank->prepare(m_options.sampleRate, numStreams, numChannels);
+            share.spBuffer = std::make_unique<juce::AudioBuffer<float>>(numStreams * numChannels, blockSize);
+        }
+
+        const double blocksPerSecond = measureBlocksPerSecond(numThreads, m_options.secondsPerThreadCount,
+            [&](int thread, const std::atomic<bool> &stop)
+        {
+            BankShare &share = shares[static_cast<size_t>(thread)];
+            juce::AudioBuffer<float> &buffer = *share.spBuffer;
+            juce::int64 numBlocks = 0;
+
+            while (!stop)
+            {
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.copyFrom(channel, 0, input, channel % numChannels, 0, blockSize);
+
+                share.spBank->process(buffer.getArrayOfWritePointers(), blockSize);
+                numBlocks += share.spBank->getNumVoices();
+            }
+
+            return numBlocks;
+        });
+
+        const double samplesPerSecond = blocksPerSecond * blockSize;
+        if (numThreads == 1)
+            singleThreadSamplesPerSecond = samplesPerSecond;
+        results.add(makeResult(name, numThreads, samplesPerSecond, singleThreadSamplesPerSecond));
+    }
+}
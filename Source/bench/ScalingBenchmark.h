@@ -0,0 +1,97 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+/**
+ * Measures how well many TremoloAudioProcessor instances scale across
+ * cores, the way a host runs a big session: hundreds of instances, created
+ * one after the other on the same thread, then processed by a pool of worker
+ * threads.
+ *
+ * Neighbouring instances go to different threads on purpose. They were
+ * allocated back to back, so that's where any state shared between
+ * instances on the same cache line shows up as poor scaling.
+ *
+ * The same number of streams then goes through TremoloBank, one bank per
+ * thread, the way a server rendering many streams would run it. Both report
+ * streamsPerCore, the number of real time streams each thread keeps up with,
+ * so the two can be compared directly.
+ *
+ * @since 2026 Oct 16
+ */
+class ScalingBenchmark
+{
+public:
+
+    /**
+     * What to run and for how long.
+     */
+    struct Options
+    {
+        int numInstances = 512;             //!< The number of processors, and of bank streams.
+        int maxThreads = 64;                //!< Thread counts double from 1 up to this, which always runs too.
+        int blockSize = 256;                //!< Samples per processBlock() call.
+        int numChannels = 2;                //!< Channels per instance.
+        double sampleRate = 48000.0;        //!< The sample rate every instance runs at.
+        double secondsPerThreadCount = 1.0; //!< How long each thread count runs for.
+    };
+
+    /**
+     * Constructor.
+     */
+    explicit ScalingBenchmark(const Options &options);
+
+    /**
+     * Runs the benchmark with 1, 2, 4, and so on up to maxThreads threads
+     * (see getThreadCounts()), first for the processors and then for the
+     * bank.
+     *
+     * @param onProgress Called with the benchmark and the number of threads before each run. May be empty.
+     * @return One JSON object per benchmark and thread count.
+     */
+    juce::Array<juce::var> run(const std::function<void(const juce::String &name, int numThreads)> &onProgress);
+
+private:
+
+    /**
+     * Returns one block of input for every stream.
+     */
+    juce::AudioBuffer<float> makeInput() const;
+
+    /**
+     * Returns the thread counts to run: the powers of 2 up to maxThreads,
+     * and maxThreads itself last if it isn't one of them.
+     */
+    std::vector<int> getThreadCounts() const;
+
+    /**
+     * Turns one run into a JSON object.
+     *
+     * @param samplesPerSecond Samples processed per second, across all streams and threads.
+     * @param singleThreadSamplesPerSecond The same for the single threaded run.
+     */
+    juce::var makeResult(const juce::String &name, int numThreads, double samplesPerSecond,
+        double singleThreadSamplesPerSecond) const;
+
+    /**
+     * Runs numInstances TremoloAudioProcessors on every thread count.
+     */
+    void runProcessors(juce::Array<juce::var> &results,
+        const std::function<void(const juce::String &name, int numThreads)> &onProgress);
+
+    /**
+     * Runs numInstances streams through TremoloBank on every thread count.
+     */
+    void runBank(juce::Array<juce::var> &results,
+        const std::function<void(const juce::String &name, int numThreads)> &onProgress);
+
+    const Options m_options; //!< What to run and for how long.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScalingBenchmark)
+};
@@ -3,6 +3,7 @@
 // Copyright(C), 2024, Shane Kirk
 
 #include "common/AudioParams.h"
+#include "common/SyncDivisions.h"
 #include <stdexcept>
 
 /**
@@ -23,6 +24,14 @@ AudioParameters::AudioParameters(juce::AudioProcessor *pProcessor)
         juce::ParameterID("gain"), "Gain", 0.0f, 1.0f, 1.0f));
     pProcessor->addParameter(m_pOscillatorType = new juce::AudioParameterChoice(
         juce::ParameterID("oscillator"), "WaveForm Type", { "Sine", "Square", "Triangle" }, 0));
+    pProcessor->addParameter(m_pBypass = new juce::AudioParameterBool(
+        juce::ParameterID("bypass"), "Bypass", false));
+    pProcessor->addParameter(m_pSpreadParamInDegrees = new juce::AudioParameterFloat(
+        juce::ParameterID("spread"), "Stereo Spread", 0.0f, 180.0f, 0.0f));
+    pProcessor->addParameter(m_pTempoSync = new juce::AudioParameterBool(
+        juce::ParameterID("sync"), "Tempo Sync", false));
+    pProcessor->addParameter(m_pSyncDivision = new juce::AudioParameterChoice(
+        juce::ParameterID("division"), "Sync Division", SyncDivisions::getNames(), SyncDivisions::DEFAULT_INDEX));
 }
 
 /**
@@ -37,6 +46,10 @@ void AudioParameters::addListener(juce::AudioProcessorParameter::Listener *pList
     m_pDepthParamInPercent->addListener(pListener);
     m_pGainParamInPercent->addListener(pListener);
     m_pOscillatorType->addListener(pListener);
+    m_pBypass->addListener(pListener);
+    m_pSpreadParamInDegrees->addListener(pListener);
+    m_pTempoSync->addListener(pListener);
+    m_pSyncDivision->addListener(pListener);
 }
 
 /**
@@ -51,6 +64,10 @@ void AudioParameters::removeListener(juce::AudioProcessorParameter::Listener *pL
     m_pDepthParamInPercent->removeListener(pListener);
     m_pGainParamInPercent->removeListener(pListener);
     m_pOscillatorType->removeListener(pListener);
+    m_pBypass->removeListener(pListener);
+    m_pSpreadParamInDegrees->removeListener(pListener);
+    m_pTempoSync->removeListener(pListener);
+    m_pSyncDivision->removeListener(pListener);
 }
 
 /**
@@ -58,7 +75,7 @@ void AudioParameters::removeListener(juce::AudioProcessorParameter::Listener *pL
  */
 void AudioParameters::saveToMemoryBlock(juce::MemoryBlock &destData)
 {
-    const size_t requiredSize = (sizeof(float) * 3) + sizeof(int);
+    const size_t requiredSize = (sizeof(float) * 4) + (sizeof(int) * 3);
 
     if (destData.getSize() < requiredSize)
         destData.setSize(requiredSize);
@@ -79,6 +96,18 @@ void AudioParameters::saveToMemoryBlock(juce::MemoryBlock &destData)
 
     int oscillatorType = *m_pOscillatorType;
     memcpy(pBytes, &oscillatorType, sizeof(int));
+    pBytes += sizeof(int);
+
+    float spreadParamInDegrees = *m_pSpreadParamInDegrees;
+    memcpy(pBytes, &spreadParamInDegrees, sizeof(float));
+    pBytes += sizeof(float);
+
+    int tempoSync = *m_pTempoSync ? 1 : 0;
+    memcpy(pBytes, &tempoSync, sizeof(int));
+    pBytes += sizeof(int);
+
+    int syncDivision = *m_pSyncDivision;
+    memcpy(pBytes, &syncDivision, sizeof(int));
 }
 
 /**
@@ -107,9 +136,35 @@ void AudioParameters::loadFromBuffer(const void *pData, int sizeInBytes)
 
     int oscillatorType = 0;
     memcpy(&oscillatorType, pBytes, sizeof(int));
+    pBytes += sizeof(int);
+
+    // Everything from here on was added later. Older states stop short of it,
+    // in which case those parameters get their defaults.
+    const unsigned char *pEnd = static_cast<const unsigned char *>(pData) + sizeInBytes;
+
+    float spreadParamInDegrees = 0.0f;
+    if (pEnd - pBytes >= static_cast<std::ptrdiff_t>(sizeof(float)))
+    {
+        memcpy(&spreadParamInDegrees, pBytes, sizeof(float));
+        pBytes += sizeof(float);
+    }
+
+    int tempoSync = 0;
+    if (pEnd - pBytes >= static_cast<std::ptrdiff_t>(sizeof(int)))
+    {
+        memcpy(&tempoSync, pBytes, sizeof(int));
+        pBytes += sizeof(int);
+    }
+
+    int syncDivision = SyncDivisions::DEFAULT_INDEX;
+    if (pEnd - pBytes >= static_cast<std::ptrdiff_t>(sizeof(int)))
+        memcpy(&syncDivision, pBytes, sizeof(int));
 
     *m_pSpeedParamInHz = speedParamInHz;
     *m_pDepthParamInPercent = depthParamInPercent;
     *m_pGainParamInPercent = gainParamInPercent;
     *m_pOscillatorType = oscillatorType;
+    *m_pSpreadParamInDegrees = spreadParamInDegrees;
+    *m_pTempoSync = (tempoSync != 0);
+    *m_pSyncDivision = syncDivision;
 }
@@ -17,6 +17,10 @@ struct AudioParameters
     juce::AudioParameterFloat *m_pDepthParamInPercent; //!< 100% goes from full gain to zero. 0% sounds like no oscillation at all.
     juce::AudioParameterFloat *m_pGainParamInPercent;  //!< Overall gain adjustment for the samples leaving the plugin.
     juce::AudioParameterChoice *m_pOscillatorType;     //!< What type of tremolo wave to use - sine, square, or triangle.
+    juce::AudioParameterBool *m_pBypass;               //!< Host bypass. Left to the host to save and restore.
+    juce::AudioParameterFloat *m_pSpreadParamInDegrees; //!< How far the right channel's tremolo runs ahead of the left's. 180 degrees is auto-pan.
+    juce::AudioParameterBool *m_pTempoSync;            //!< When on, the tremolo follows the host's tempo and m_pSyncDivision rather than the speed.
+    juce::AudioParameterChoice *m_pSyncDivision;       //!< The note division one tremolo oscillation lasts when synced to the host's tempo.
 
     /**
      * Constructor.
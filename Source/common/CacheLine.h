@@ -0,0 +1,71 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstddef>
+#include <new>
+
+/**
+ * Helpers for keeping data that different threads write out of each
+ * other's cache lines. When two threads write to the same cache line, even
+ * to different variables on it, the line bounces between their cores and
+ * both slow down. Hosts run hundreds of plugin instances spread across their
+ * worker threads, so that's as much about neighbouring instances on the heap
+ * as it is about threads within one instance.
+ */
+namespace CacheLine
+{
+    /**
+     * The size we align and pad to. Apple silicon has 128 byte lines, and
+     * Intel CPUs fetch lines in pairs, so 128 bytes would be safer yet, but
+     * at twice the padding. 64 bytes is the line size everywhere else.
+     */
+#if JUCE_ARM && JUCE_MAC
+    constexpr size_t SIZE = 128;
+#else
+    constexpr size_t SIZE = 64;
+#endif
+
+    /**
+     * Rounds the given number of bytes up to a whole number of cache lines.
+     */
+    constexpr size_t roundUp(size_t numBytes)
+    {
+        return (numBytes + SIZE - 1) / SIZE * SIZE;
+    }
+
+    /**
+     * A standard allocator whose allocations start on a cache line and take
+     * up whole cache lines, so nothing else on the heap ever shares a line
+     * with them.
+     */
+    template <typename T>
+    struct Allocator
+    {
+        using value_type = T;
+
+        Allocator() = default;
+
+        template <typename U>
+        Allocator(const Allocator<U> &) {}
+
+        T *allocate(size_t count)
+        {
+            return static_cast<T *>(::operator new(roundUp(count * sizeof(T)), std::align_val_t(SIZE)));
+        }
+
+        void deallocate(T *pData, size_t)
+        {
+            ::operator delete(pData, std::align_val_t(SIZE));
+        }
+
+        template <typename U>
+        bool operator==(const Allocator<U> &) const { return true; }
+
+        template <typename U>
+        bool operator!=(const Allocator<U> &) const { return false; }
+    };
+}
@@ -0,0 +1,51 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <iterator>
+
+/**
+ * The note divisions tempo sync can lock one oscillation to, from a whole
+ * note down to a 64th note, each straight, dotted, or triplet. The sync
+ * division parameter's choices are these, in this order. TempoSync turns
+ * them into frequencies and phases.
+ */
+namespace SyncDivisions
+{
+    //! The note values we sync to, from a whole note down to a 64th note.
+    constexpr int NOTE_VALUES[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+    //! Every note value comes in three flavors, in this order.
+    enum class DivisionType
+    {
+        Straight,
+        Dotted,
+        Triplet
+    };
+
+    //! The number of divisions to choose from.
+    constexpr int NUM_DIVISIONS = static_cast<int>(std::size(NOTE_VALUES)) * 3;
+
+    //! The division selected by default, a straight quarter note.
+    constexpr int DEFAULT_INDEX = 2 * 3;
+
+    /**
+     * Returns the names of all divisions, such as "1/4", "1/4." (dotted) and
+     * "1/4T" (triplet), in the order of their indices.
+     */
+    inline juce::StringArray getNames()
+    {
+        juce::StringArray names;
+        for (int noteValue : NOTE_VALUES)
+        {
+            const juce::String name = "1/" + juce::String(noteValue);
+            names.add(name);
+            names.add(name + ".");
+            names.add(name + "T");
+        }
+        return names;
+    }
+}
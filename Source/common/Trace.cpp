@@ -0,0 +1,155 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "common/Trace.h"
+
+#if TREMOLO_TRACE
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace
+{
+    /**
+     * One finished scope.
+     */
+    struct Event
+    {
+        const char *pName;      //!< What was timed.
+        juce::int64 startTicks; //!< When it started, in high resolution ticks.
+        juce::int64 endTicks;   //!< When it ended.
+    };
+
+    /**
+     * The events of one thread, about 400 KB. Only that thread writes to it.
+     */
+    struct ThreadBuffer
+    {
+        std::array<Event, Trace::EVENTS_PER_THREAD> events; //!< The most recent events, oldest overwritten first.
+        std::atomic<juce::int64> numEvents{ 0 };            //!< Events ever recorded. The next one goes at numEvents % EVENTS_PER_THREAD.
+    };
+
+    /**
+     * A slot for every thread's buffer. The buffers are allocated one thread
+     * at a time, by Trace::prepareThread() or the thread's first event, so a
+     * binary that traces one thread only ever writes to one buffer.
+     */
+    struct Registry
+    {
+        Registry() = default;
+
+        ~Registry()
+        {
+            for (std::atomic<ThreadBuffer *> &buffer : buffers)
+                delete buffer.load();
+        }
+
+        std::array<std::atomic<ThreadBuffer *>, Trace::MAX_THREADS> buffers{};  //!< One per thread that has traced, in the order they started.
+        std::atomic<int> numClaimed{ 0 };                                      //!< Slots handed out so far.
+        const juce::int64 originTicks = juce::Time::getHighResolutionTicks();  //!< Time zero in the output.
+
+        JUCE_DECLARE_NON_COPYABLE(Registry)
+    };
+
+    Registry &getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    //! Sets the (small) registry up before main(), so time zero is when the program started.
+    [[maybe_unused]] const Registry &g_registryAtStartup = getRegistry();
+
+    /**
+     * Returns the calling thread's buffer, claiming a slot and allocating the
+     * buffer on first use. Returns nullptr if every slot is taken.
+     *
+     * The buffer is zeroed as it's allocated. That makes the OS hand over
+     * every page right away, rather than one page fault at a time as the
+     * events first land on them, which would be in the middle of whatever
+     * is being traced.
+     */
+    ThreadBuffer *getThreadBuffer()
+    {
+        thread_local ThreadBuffer *pBuffer = []() -> ThreadBuffer *
+        {
+            Registry &registry = getRegistry();
+            const int index = registry.numClaimed.fetch_add(1);
+            if (index >= Trace::MAX_THREADS)
+                return nullptr;
+
+            auto *pNewBuffer = new ThreadBuffer();
+            registry.buffers[static_cast<size_t>(index)].store(pNewBuffer, std::memory_order_release);
+            return pNewBuffer;
+        }();
+        return pBuffer;
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void Trace::prepareThread()
+{
+    getThreadBuffer();
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+Trace::Scope::~Scope()
+{
+    ThreadBuffer *pBuffer = getThreadBuffer();
+    if (!pBuffer)
+        return;
+
+    // We're the only writer, so a plain load and store will do.
+    const juce::int64 index = pBuffer->numEvents.load(std::memory_order_relaxed);
+    pBuffer->events[static_cast<size_t>(index % EVENTS_PER_THREAD)] = { m_pName, m_startTicks, juce::Time::getHighResolutionTicks() };
+    pBuffer->numEvents.store(index + 1, std::memory_order_release);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+bool Trace::writeChromeJson(const juce::File &file)
+{
+    Registry &registry = getRegistry();
+    const int numThreads = std::min(registry.numClaimed.load(), MAX_THREADS);
+    const double ticksPerMicrosecond = juce::Time::getHighResolutionTicksPerSecond() / 1e6;
+
+    juce::Array<juce::var> traceEvents;
+    for (int thread = 0; thread < numThreads; ++thread)
+    {
+        // A slot can be claimed before its buffer shows up.
+        const ThreadBuffer *pBuffer = registry.buffers[static_cast<size_t>(thread)].load(std::memory_order_acquire);
+        if (!pBuffer)
+            continue;
+
+        const ThreadBuffer &buffer = *pBuffer;
+        const juce::int64 numEvents = buffer.numEvents.load(std::memory_order_acquire);
+
+        for (juce::int64 i = std::max<juce::int64>(numEvents - EVENTS_PER_THREAD, 0); i < numEvents; ++i)
+        {
+            const Event &event = buffer.events[static_cast<size_t>(i % EVENTS_PER_THREAD)];
+
+            auto *pEvent = new juce::DynamicObject();
+            pEvent->setProperty("name", event.pName);
+            pEvent->setProperty("ph", "X");
+            pEvent->setProperty("ts", (event.startTicks - registry.originTicks) / ticksPerMicrosecond);
+            pEvent->setProperty("dur", (event.endTicks - event.startTicks) / ticksPerMicrosecond);
+            pEvent->setProperty("pid", 1);
+            pEvent->setProperty("tid", thread + 1);
+            traceEvents.add(juce::var(pEvent));
+        }
+    }
+
+    auto *pTrace = new juce::DynamicObject();
+    pTrace->setProperty("traceEvents", traceEvents);
+    pTrace->setProperty("displayTimeUnit", "ns");
+    return file.replaceWithText(juce::JSON::toString(juce::var(pTrace), true));
+}
+
+#endif
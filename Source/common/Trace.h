@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/**
+ * Trace scopes for seeing where the time goes, block by block, alongside
+ * parameter changes and repaints. Off unless the build defines
+ * TREMOLO_TRACE=1. When it's off, TREMOLO_TRACE_SCOPE expands to nothing,
+ * so release builds pay nothing at all.
+ *
+ * When it's on, every scope records its name, start, and end into a ring
+ * buffer that belongs to the thread it ran on, so only threads that trace
+ * pay for one. A thread claims a slot with a single atomic increment and
+ * allocates its buffer, about 400 KB, in prepareThread(). A thread that
+ * never called it allocates on its first trace instead, inside whatever it
+ * was timing. From then on, tracing never allocates or locks. Once a buffer
+ * wraps around, its oldest events are dropped.
+ *
+ * The headless tools write everything out as Chrome trace event JSON with
+ * --trace=<file>, for chrome://tracing or https://ui.perfetto.dev.
+ */
+#ifndef TREMOLO_TRACE
+ #define TREMOLO_TRACE 0
+#endif
+
+#if TREMOLO_TRACE
+
+namespace Trace
+{
+    //! The number of events each thread keeps.
+    constexpr int EVENTS_PER_THREAD = 16384;
+
+    //! The number of threads that can trace. Threads beyond this aren't traced.
+    constexpr int MAX_THREADS = 64;
+
+    /**
+     * Records the time from construction to destruction under the given name.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param pName What's being timed. Must outlive the trace, so a string literal.
+         */
+        explicit Scope(const char *pName)
+            : m_pName(pName),
+              m_startTicks(juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~Scope();
+
+    private:
+
+        const char *m_pName;            //!< What's being timed.
+        const juce::int64 m_startTicks; //!< When the scope was entered.
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    /**
+     * Claims the calling thread's slot and allocates its buffer, if it hasn't
+     * already, and touches every page of it so none fault later. Call it on
+     * every thread that traces before it does anything time critical, like
+     * processing audio. Does nothing once every slot is taken.
+     */
+    void prepareThread();
+
+    /**
+     * Writes every event recorded so far as Chrome trace event JSON. Call it
+     * once the threads being traced are done, at the end of a render or a
+     * benchmark. Events recorded while it runs may or may not make it in.
+     *
+     * @return False if the file couldn't be written.
+     */
+    bool writeChromeJson(const juce::File &file);
+}
+
+ #define TREMOLO_TRACE_SCOPE(name) const Trace::Scope JUCE_JOIN_MACRO(traceScope_, __LINE__)(name)
+ #define TREMOLO_TRACE_PREPARE_THREAD() Trace::prepareThread()
+
+#else
+
+ #define TREMOLO_TRACE_SCOPE(name)
+ #define TREMOLO_TRACE_PREPARE_THREAD()
+
+#endif
@@ -0,0 +1,92 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "CacheLine.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+
+/**
+ * Lock-free handoff of a value from one writer thread to one reader thread.
+ *
+ * The writer fills in getWriteBuffer() and then calls publish(). The reader
+ * calls getReadBuffer(), which returns the most recently published value.
+ * Neither side ever waits on the other and neither side ever sees a value
+ * the other is still touching. It takes three slots to pull that off: one
+ * owned by the writer, one owned by the reader, and one in the middle that
+ * gets swapped back and forth.
+ *
+ * If more than one thread writes, the writers must serialize themselves.
+ *
+ * Every slot and index sits on cache lines of its own, so the writer filling
+ * in its slot never slows down the reader reading its own.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    TripleBuffer() :
+        m_middleIndex(1)
+    {
+        static_assert(std::atomic<int>::is_always_lock_free,
+            "Cannot perform atomic operations on target platform without locking.");
+    }
+
+    /**
+     * Returns the slot the writer is free to modify. Writer thread only.
+     */
+    T &getWriteBuffer() { return m_buffers[m_writeIndex].value; }
+
+    /**
+     * Makes the contents of getWriteBuffer() available to the reader.
+     * getWriteBuffer() returns a different slot afterwards, the contents of
+     * which are undefined. Writer thread only.
+     */
+    void publish()
+    {
+        m_writeIndex = m_middleIndex.exchange(m_writeIndex | FRESH_FLAG) & INDEX_MASK;
+    }
+
+    /**
+     * Returns true if something has been published since the reader last
+     * called getReadBuffer().
+     */
+    bool hasNewData() const { return (m_middleIndex.load() & FRESH_FLAG) != 0; }
+
+    /**
+     * Returns the most recently published value. Reader thread only.
+     */
+    T &getReadBuffer()
+    {
+        if (hasNewData())
+            m_readIndex = m_middleIndex.exchange(m_readIndex) & INDEX_MASK;
+        return m_buffers[m_readIndex].value;
+    }
+
+private:
+
+    static constexpr int INDEX_MASK = 0x3;
+    static constexpr int FRESH_FLAG = 0x4;
+
+    /**
+     * One slot, padded out to whole cache lines.
+     */
+    struct alignas(CacheLine::SIZE) Slot
+    {
+        T value;
+    };
+
+    std::array<Slot, 3> m_buffers;                           //!< Reader slot, middle slot, and writer slot. Which is which changes over time.
+    alignas(CacheLine::SIZE) int m_readIndex = 0;            //!< The slot owned by the reader.
+    alignas(CacheLine::SIZE) std::atomic<int> m_middleIndex; //!< The slot in the middle, plus FRESH_FLAG if the writer has published into it.
+    alignas(CacheLine::SIZE) int m_writeIndex = 2;           //!< The slot owned by the writer.
+
+    JUCE_DECLARE_NON_COPYABLE(TripleBuffer)
+};
@@ -0,0 +1,192 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "EnvelopeTable.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * How the sine wave shape is evaluated between control points.
+ */
+enum class LfoInterpolation
+{
+    None,   //!< The shape is evaluated for every sample (audio rate).
+    Linear, //!< The shape is evaluated every few samples and linearly interpolated in between.
+    Cubic   //!< The shape is evaluated every few samples and interpolated with a 4 point Lagrange cubic in between.
+};
+
+/**
+ * A low CPU alternative to evaluating the sine wave shape for every sample.
+ * The tremolo tops out at 40 Hz, so the shape barely moves from one sample
+ * to the next. Instead, we evaluate it every few samples (the control
+ * interval) and interpolate in between.
+ *
+ * The control interval is picked from the phase delta (speed / sample rate)
+ * so the interpolation error never exceeds MAX_ERROR. Higher sample rates
+ * and slower speeds allow for longer intervals.
+ *
+ * Once the intervals get long, the per-sample interpolation, not the shape
+ * evaluation, is what dominates the cost.
+ *
+ * Square and triangle shapes are never interpolated. They're already cheaper
+ * to calculate than an interpolated value and the square's edges would get
+ * smeared.
+ */
+namespace ControlRateLfo
+{
+    //! The largest interpolation error we allow, on the -1.0 to 1.0 shape value (-80 dB).
+    constexpr double MAX_ERROR = 1e-4;
+
+    //! The longest control interval we'll ever use, in samples.
+    constexpr int MAX_INTERVAL = 64;
+
+    /**
+     * Returns the worst case error of interpolating the sine shape between
+     * control points that are the given distance apart.
+     *
+     * The interpolation bounds come from the interpolation remainder theorem
+     * using the largest derivative of -cos(2 * pi * phase), which is
+     * (2 * pi)^n. On top of that, the control points are read from the
+     * linearly interpolated sine table, so each one can be off by the
+     * table's own error. Linear interpolation passes that on as is. The
+     * cubic can grow it by up to its Lebesgue constant, 1.25 (at t = 0.5,
+     * the weights are -1/16, 9/16, 9/16, -1/16).
+     *
+     * @param interpolation The interpolation.
+     * @param controlPhaseDelta The phase between two control points.
+     * @param tableSize The size of the sine table the control points come from.
+     */
+    inline double maxAbsoluteError(LfoInterpolation interpolation, double controlPhaseDelta, int tableSize)
+    {
+        const double twoPi = juce::MathConstants<double>::twoPi;
+        const double h = controlPhaseDelta;
+        const double tableError = EnvelopeTable::maxSineInterpolationError(tableSize);
+
+        switch (interpolation)
+        {
+            // f'' * h^2 / 8
+            case LfoInterpolation::Linear: return twoPi * twoPi * h * h / 8.0 + tableError;
+
+            // f'''' * h^4 * max|(t + 1)t(t - 1)(t - 2)| / 4!, where the max is 9/16.
+            case LfoInterpolation::Cubic:  return std::pow(twoPi * h, 4.0) * (9.0 / 16.0) / 24.0 + 1.25 * tableError;
+
+            case LfoInterpolation::None:
+            default:                       return 0.0;
+        }
+    }
+
+    /**
+     * Returns the longest control interval (a power of 2, no more than
+     * MAX_INTERVAL) that keeps the interpolation error below MAX_ERROR.
+     * Returns 1 if there's nothing to be gained from interpolating.
+     *
+     * @param interpolation The interpolation.
+     * @param phaseDelta How much the phase advances with every sample.
+     * @param tableSize The size of the sine table the control points come from.
+     */
+    inline int chooseInterval(LfoInterpolation interpolation, double phaseDelta, int tableSize)
+    {
+        if (interpolation == LfoInterpolation::None)
+            return 1;
+
+        int interval = MAX_INTERVAL;
+        while (interval > 1 && maxAbsoluteError(interpolation, phaseDelta * interval, tableSize) > MAX_ERROR)
+            interval /= 2;
+        return interval;
+    }
+
+    //! Straight line between the two control points around the segment.
+    struct LinearInterpolation
+    {
+        /**
+         * Fills one segment between points[1] and points[2].
+         *
+         * @param points The 4 control points around the segment.
+         * @param step The distance between two samples, relative to the control interval.
+         * @param pDest The buffer to fill.
+         * @param numValues The number of values in the segment.
+         */
+        static forcedinline void renderSegment(const double (&points)[4], double step, double *pDest, int numValues)
+        {
+            const double slope = points[2] - points[1];
+            for (int i = 0; i < numValues; ++i)
+                pDest[i] = points[1] + slope * (step * i);
+        }
+    };
+
+    //! 4 point Lagrange cubic through the control points around the segment.
+    struct CubicInterpolation
+    {
+        /**
+         * Fills one segment between points[1] and points[2].
+         *
+         * @param points The 4 control points around the segment.
+         * @param step The distance between two samples, relative to the control interval.
+         * @param pDest The buffer to fill.
+         * @param numValues The number of values in the segment.
+         */
+        static forcedinline void renderSegment(const double (&points)[4], double step, double *pDest, int numValues)
+        {
+            const double c0 = points[1];
+            const double c1 = points[2] - points[0] / 3.0 - points[1] / 2.0 - points[3] / 6.0;
+            const double c2 = (points[0] + points[2]) / 2.0 - points[1];
+            const double c3 = (points[3] - points[0]) / 6.0 + (points[1] - points[2]) / 2.0;
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                const double t = step * i;
+                pDest[i] = ((c3 * t + c2) * t + c1) * t + c0;
+            }
+        }
+    };
+
+    /**
+     * Returns the sine shape at the given phase, which may be negative or
+     * greater than 1.0.
+     */
+    inline double controlPointAt(const EnvelopeTable &sineTable, double phase)
+    {
+        return sineTable.valueAt(phase - std::floor(phase));
+    }
+
+    /**
+     * Fills the provided buffer with sine shape values (-1.0 to 1.0),
+     * starting at startPhase and advancing by phaseDelta with every value.
+     * The shape is only evaluated every interval samples.
+     *
+     * @param sineTable The sine shape.
+     * @param startPhase The phase of the first value. Must not be negative.
+     * @param phaseDelta How much the phase advances with every value. Must not be negative.
+     * @param interval The control interval. See chooseInterval().
+     * @param pDest The buffer to fill. Must have room for at least numValues values.
+     * @param numValues The number of values to calculate.
+     */
+    template <typename Interpolation>
+    forcedinline void render(const EnvelopeTable &sineTable, double startPhase, double phaseDelta, int interval, double *pDest, int numValues)
+    {
+        // Control point m sits at sample m * interval. We keep the ones just
+        // before and after the current segment around for the cubic.
+        const double controlPhaseDelta = phaseDelta * interval;
+        const double step = 1.0 / interval;
+
+        double points[4];
+        for (int m = 0; m < 4; ++m)
+            points[m] = controlPointAt(sineTable, startPhase + controlPhaseDelta * (m - 1));
+
+        int controlIndex = 0;
+        for (int segmentStart = 0; segmentStart < numValues; segmentStart += interval)
+        {
+            Interpolation::renderSegment(points, step, pDest + segmentStart, std::min(interval, numValues - segmentStart));
+
+            ++controlIndex;
+            points[0] = points[1];
+            points[1] = points[2];
+            points[2] = points[3];
+            points[3] = controlPointAt(sineTable, startPhase + controlPhaseDelta * (controlIndex + 2));
+        }
+    }
+}
@@ -0,0 +1,104 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "WaveShapes.h"
+#include <juce_core/juce_core.h>
+#include <vector>
+
+/**
+ * One full period of a tremolo wave shape, sampled at a fixed number of
+ * evenly spaced phases. Once it's built, getting the shape at any phase is
+ * just a table read with linear interpolation, which is cheaper than
+ * evaluating a curve like the sine from scratch for every sample.
+ *
+ * The table is indexed by the normalized phase, so it doesn't depend on
+ * the sample rate or speed. Its size is picked when it's built, since the
+ * interpolation error shrinks with the square of the size. See
+ * SineKernel::getTableSize().
+ */
+class EnvelopeTable
+{
+public:
+
+    //! Number of points in one period, unless told otherwise.
+    static constexpr int DEFAULT_SIZE = 2048;
+
+    /**
+     * Returns the worst case error of linearly interpolating a sine from a
+     * table of the given size: f'' * h^2 / 8, with f'' = (2 * pi)^2 and
+     * h = 1 / tableSize. About 1.2e-6 for DEFAULT_SIZE.
+     */
+    static constexpr double maxSineInterpolationError(int tableSize)
+    {
+        return (juce::MathConstants<double>::twoPi / tableSize) * (juce::MathConstants<double>::twoPi / tableSize) / 8.0;
+    }
+
+    /**
+     * Constructor. The table starts out flat.
+     */
+    EnvelopeTable() : m_values(static_cast<size_t>(DEFAULT_SIZE + 1), 0.0) {}
+
+    /**
+     * Fills the table with one period of the given wave shape. Allocates if
+     * the size changes, so don't call it on the audio thread.
+     *
+     * @param renderShape The wave shape renderer.
+     * @param tableSize The number of points in one period.
+     */
+    void build(WaveShapes::BlockRenderFunction renderShape, int tableSize = DEFAULT_SIZE)
+    {
+        // The extra value at the end is a copy of the first value (phase 1.0
+        // wraps to 0.0), so the interpolation never has to wrap.
+        m_values.resize(static_cast<size_t>(tableSize + 1));
+        m_size = tableSize;
+        renderShape(0.0, 1.0 / tableSize, m_values.data(), tableSize + 1);
+    }
+
+    /**
+     * Returns the number of points in one period.
+     */
+    int getSize() const { return static_cast<int>(m_size); }
+
+    /**
+     * Returns the interpolated shape value at the given phase.
+     *
+     * @param phase The phase, 0.0 <= phase < 1.0.
+     */
+    double valueAt(double phase) const
+    {
+        const double *pValues = m_values.data();
+        const double position = phase * m_size;
+        const int index = static_cast<int>(position);
+        const double fraction = position - index;
+        return pValues[index] + fraction * (pValues[index + 1] - pValues[index]);
+    }
+
+    /**
+     * Fills the provided buffer with interpolated shape values,
+     * starting at startPhase and advancing by phaseDelta with every value.
+     *
+     * @param startPhase The phase of the first value. Must not be negative.
+     * @param phaseDelta How much the phase advances with every value. Must not be negative.
+     * @param pDest The buffer to fill. Must have room for at least numValues values.
+     * @param numValues The number of values to calculate.
+     */
+    void renderBlock(double startPhase, double phaseDelta, double *pDest, int numValues) const
+    {
+        for (int i = 0; i < numValues; ++i)
+        {
+            double phase = startPhase + phaseDelta * i;
+            phase = phase - static_cast<int>(phase);
+            pDest[i] = valueAt(phase);
+        }
+    }
+
+private:
+
+    std::vector<double> m_values;    //!< One period of the wave shape plus a guard value.
+    double m_size = DEFAULT_SIZE;    //!< The number of points in one period, as a double for the index math.
+
+    JUCE_DECLARE_NON_COPYABLE(EnvelopeTable)
+};
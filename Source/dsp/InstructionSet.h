@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/**
+ * The instruction set levels our DSP kernels are compiled for. We ship a
+ * single binary, so kernels are compiled once per level and the best one
+ * the machine supports is picked at runtime.
+ *
+ * Only GCC and Clang let us compile individual functions for a different
+ * instruction set than the rest of the binary. Everywhere else, MSVC
+ * included, only InstructionSet::Generic is available, which the README
+ * points out. MSVC would need each level in a translation unit of its own,
+ * built with its own /arch flag, with every inline function it uses kept
+ * out of the others' way so the linker can't pick the wrong copy.
+ */
+enum class InstructionSet
+{
+    Generic, //!< Whatever the compiler targets by default (SSE2 on x86-64).
+    SSE42,   //!< SSE 4.2.
+    AVX2,    //!< AVX2 and FMA.
+    AVX512   //!< AVX-512 F/DQ/VL.
+};
+
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+ #define TREMOLO_HAS_ISA_DISPATCH 1
+ #define TREMOLO_TARGET_SSE42  __attribute__((target("sse4.2")))
+ #define TREMOLO_TARGET_AVX2   __attribute__((target("avx2,fma")))
+ #define TREMOLO_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512vl,avx2,fma")))
+#else
+ #define TREMOLO_HAS_ISA_DISPATCH 0
+#endif
+
+namespace InstructionSets
+{
+    //! Environment variable that forces a particular instruction set, for testing.
+    //! Accepts "generic", "sse42", "avx2", or "avx512".
+    constexpr const char *OVERRIDE_ENV_VAR = "SKTREMOLO_ISA";
+
+    /**
+     * Returns the name of the given instruction set, as accepted by OVERRIDE_ENV_VAR.
+     */
+    inline const char *getName(InstructionSet instructionSet)
+    {
+        switch (instructionSet)
+        {
+            case InstructionSet::SSE42:  return "sse42";
+            case InstructionSet::AVX2:   return "avx2";
+            case InstructionSet::AVX512: return "avx512";
+            case InstructionSet::Generic:
+            default:                     return "generic";
+        }
+    }
+
+    /**
+     * Returns the best instruction set that both the CPU and this build support.
+     */
+    inline InstructionSet detectBest()
+    {
+#if TREMOLO_HAS_ISA_DISPATCH
+        if (juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512DQ() && juce::SystemStats::hasAVX512VL())
+            return InstructionSet::AVX512;
+        if (juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3())
+            return InstructionSet::AVX2;
+        if (juce::SystemStats::hasSSE42())
+            return InstructionSet::SSE42;
+#endif
+        return InstructionSet::Generic;
+    }
+
+    /**
+     * Returns the instruction set our kernels should use. That's the best one
+     * available unless OVERRIDE_ENV_VAR asks for something else. Requests for
+     * an instruction set the machine can't run are capped to the best one it can.
+     */
+    inline InstructionSet select()
+    {
+        const InstructionSet best = detectBest();
+        const juce::String requested = juce::SystemStats::getEnvironmentVariable(OVERRIDE_ENV_VAR, {}).trim().toLowerCase();
+
+        for (auto instructionSet : { InstructionSet::Generic, InstructionSet::SSE42, InstructionSet::AVX2, InstructionSet::AVX512 })
+        {
+            if (requested == getName(instructionSet))
+                return std::min(instructionSet, best);
+        }
+
+        return best;
+    }
+}
@@ -0,0 +1,237 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "common/CacheLine.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+/**
+ * Keeps track of how long the processor takes per block, compared to how
+ * long it has before the host needs the block back (its time budget). It
+ * tells us whether dropouts on a machine are ours or the host's: if our
+ * blocks never come close to the budget, it isn't us.
+ *
+ * Timing a block costs two reads of the CPU's time stamp counter and a
+ * handful of relaxed atomic stores. No locks, no syscalls. The audio thread
+ * is the only writer. Any thread may take a snapshot at any time, though a
+ * snapshot taken mid-block may mix counters from two blocks.
+ *
+ * @since 2026 Oct 16
+ */
+class alignas(CacheLine::SIZE) PerformanceMonitor
+{
+public:
+
+    //! Histogram bins: ten for 0% to 100% of the budget in steps of 10%, plus one for over budget.
+    static constexpr int NUM_HISTOGRAM_BINS = 11;
+
+    /**
+     * The counters at one point in time.
+     */
+    struct Snapshot
+    {
+        uint64_t numBlocks = 0;           //!< Blocks processed since the last reset.
+        uint64_t numOverBudgetBlocks = 0; //!< Blocks that took longer than their budget.
+        double lastBlockSeconds = 0.0;    //!< How long the most recent block took.
+        double averageBlockSeconds = 0.0; //!< How long a block takes on average.
+        double maxBlockSeconds = 0.0;     //!< How long the slowest block took.
+        double averageBudgetUsed = 0.0;   //!< Total compute time over total block duration. 1.0 is all of it.
+        double maxBudgetUsed = 0.0;       //!< The most of its budget any one block used.
+
+        std::array<uint64_t, NUM_HISTOGRAM_BINS> histogram{}; //!< The number of blocks per budget bin.
+    };
+
+    /**
+     * Times one block, from construction to destruction.
+     */
+    class ScopedBlock
+    {
+    public:
+
+        ScopedBlock(PerformanceMonitor &monitor, int numSamples)
+            : m_monitor(monitor),
+              m_numSamples(numSamples),
+              m_startTicks(readTicks())
+        {
+        }
+
+        ~ScopedBlock() { m_monitor.recordBlock(m_startTicks, m_numSamples); }
+
+    private:
+
+        PerformanceMonitor &m_monitor; //!< Where the block is recorded.
+        const int m_numSamples;        //!< The length of the block.
+        const uint64_t m_startTicks;   //!< When the block started.
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    };
+
+    /**
+     * Constructor.
+     */
+    PerformanceMonitor() = default;
+
+    /**
+     * Sets the sample rate the budgets are worked out from, and starts
+     * counting over. Not real-time safe. The first call in a process spends
+     * a couple of milliseconds measuring the time stamp counter's rate.
+     */
+    void prepare(double sampleRate)
+    {
+        m_ticksPerSample = (sampleRate > 0.0) ? getTicksPerSecond() / sampleRate : 0.0;
+        reset();
+    }
+
+    /**
+     * Asks the audio thread to start counting over with its next block. Safe
+     * to call from any thread.
+     */
+    void reset() { m_resetRequested = true; }
+
+    /**
+     * Records a block that started at startTicks and ends now. Audio thread only.
+     *
+     * @param startTicks What readTicks() returned when the block started.
+     * @param numSamples The length of the block.
+     */
+    void recordBlock(uint64_t startTicks, int numSamples)
+    {
+        const uint64_t elapsedTicks = readTicks() - startTicks;
+        const double budgetTicks = numSamples * m_ticksPerSample;
+        if (budgetTicks <= 0.0)
+            return;
+
+        if (m_resetRequested.load(std::memory_order_relaxed) && m_resetRequested.exchange(false, std::memory_order_relaxed))
+            clearCounters();
+
+        const double budgetUsed = elapsedTicks / budgetTicks;
+        const int bin = (budgetUsed > 1.0) ? NUM_HISTOGRAM_BINS - 1
+                                           : std::min(static_cast<int>(budgetUsed * 10.0), NUM_HISTOGRAM_BINS - 2);
+
+        // We're the only writer, so there's no need for read-modify-write atomics.
+        increment(m_histogram[static_cast<size_t>(bin)]);
+        increment(m_numBlocks);
+        add(m_totalTicks, elapsedTicks);
+        add(m_totalBudgetTicks, static_cast<uint64_t>(budgetTicks));
+        m_lastBlockTicks.store(elapsedTicks, std::memory_order_relaxed);
+        if (elapsedTicks > m_maxBlockTicks.load(std::memory_order_relaxed))
+            m_maxBlockTicks.store(elapsedTicks, std::memory_order_relaxed);
+        if (budgetUsed > m_maxBudgetUsed.load(std::memory_order_relaxed))
+            m_maxBudgetUsed.store(budgetUsed, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the counters as they are right now. Safe to call from any thread.
+     */
+    Snapshot getSnapshot() const
+    {
+        const double ticksPerSecond = getTicksPerSecond();
+        const uint64_t totalTicks = m_totalTicks.load(std::memory_order_relaxed);
+        const uint64_t totalBudgetTicks = m_totalBudgetTicks.load(std::memory_order_relaxed);
+
+        Snapshot snapshot;
+        snapshot.numBlocks = m_numBlocks.load(std::memory_order_relaxed);
+        for (size_t bin = 0; bin < snapshot.histogram.size(); ++bin)
+            snapshot.histogram[bin] = m_histogram[bin].load(std::memory_order_relaxed);
+        snapshot.numOverBudgetBlocks = snapshot.histogram.back();
+        snapshot.lastBlockSeconds = m_lastBlockTicks.load(std::memory_order_relaxed) / ticksPerSecond;
+        snapshot.maxBlockSeconds = m_maxBlockTicks.load(std::memory_order_relaxed) / ticksPerSecond;
+        snapshot.averageBlockSeconds = (snapshot.numBlocks > 0) ? totalTicks / ticksPerSecond / snapshot.numBlocks : 0.0;
+        snapshot.averageBudgetUsed = (totalBudgetTicks > 0) ? static_cast<double>(totalTicks) / totalBudgetTicks : 0.0;
+        snapshot.maxBudgetUsed = m_maxBudgetUsed.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    /**
+     * Reads the clock blocks are timed with: the time stamp counter on x86,
+     * JUCE's high resolution ticks everywhere else.
+     */
+    static uint64_t readTicks()
+    {
+#if JUCE_INTEL
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(juce::Time::getHighResolutionTicks());
+#endif
+    }
+
+    /**
+     * Returns how fast readTicks() ticks. Measured the first time it's called.
+     */
+    static double getTicksPerSecond()
+    {
+#if JUCE_INTEL
+        // The time stamp counter runs at a constant rate on anything made in
+        // the last 15 years, but nothing tells us what that rate is. Timing
+        // it against the high resolution clock for a couple of milliseconds
+        // gets it to within a fraction of a percent.
+        static const double ticksPerSecond = []
+        {
+            const juce::int64 startTime = juce::Time::getHighResolutionTicks();
+            const uint64_t startTicks = readTicks();
+            const juce::int64 calibrationTime = juce::Time::getHighResolutionTicksPerSecond() / 500;
+
+            juce::int64 elapsedTime = 0;
+            while (elapsedTime < calibrationTime)
+                elapsedTime = juce::Time::getHighResolutionTicks() - startTime;
+
+            return (readTicks() - startTicks) / juce::Time::highResolutionTicksToSeconds(elapsedTime);
+        }();
+        return ticksPerSecond;
+#else
+        return static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+#endif
+    }
+
+private:
+
+    /**
+     * Zeroes every counter. Audio thread only.
+     */
+    void clearCounters()
+    {
+        for (auto &count : m_histogram)
+            count.store(0, std::memory_order_relaxed);
+        m_numBlocks.store(0, std::memory_order_relaxed);
+        m_totalTicks.store(0, std::memory_order_relaxed);
+        m_totalBudgetTicks.store(0, std::memory_order_relaxed);
+        m_lastBlockTicks.store(0, std::memory_order_relaxed);
+        m_maxBlockTicks.store(0, std::memory_order_relaxed);
+        m_maxBudgetUsed.store(0.0, std::memory_order_relaxed);
+    }
+
+    static void increment(std::atomic<uint64_t> &counter) { add(counter, 1); }
+
+    static void add(std::atomic<uint64_t> &counter, uint64_t amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    double m_ticksPerSample = 0.0; //!< Ticks per sample of audio. Set in prepare().
+
+    std::array<std::atomic<uint64_t>, NUM_HISTOGRAM_BINS> m_histogram{}; //!< The number of blocks per budget bin.
+    std::atomic<uint64_t> m_numBlocks{ 0 };        //!< Blocks recorded since the last reset.
+    std::atomic<uint64_t> m_totalTicks{ 0 };       //!< Time spent on those blocks.
+    std::atomic<uint64_t> m_totalBudgetTicks{ 0 }; //!< The sum of their budgets.
+    std::atomic<uint64_t> m_lastBlockTicks{ 0 };   //!< Time spent on the most recent block.
+    std::atomic<uint64_t> m_maxBlockTicks{ 0 };    //!< Time spent on the slowest block.
+    std::atomic<double> m_maxBudgetUsed{ 0.0 };    //!< The most of its budget any block used.
+
+    alignas(CacheLine::SIZE) std::atomic<bool> m_resetRequested{ false }; //!< Set by reset(). Written by other threads, so on a line of its own.
+
+    JUCE_DECLARE_NON_COPYABLE(PerformanceMonitor)
+};
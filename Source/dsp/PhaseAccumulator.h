@@ -0,0 +1,197 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "common/CacheLine.h"
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Tracks the phase of the tremolo oscillation. The phase is normalized such
+ * that a full cycle goes from 0.0 up to (but not including) 1.0. This is the
+ * one and only phase engine in the plugin. The wave shapes in WaveShapes.h
+ * are just functions of this phase, so every waveform is always in step with
+ * every other waveform.
+ *
+ * Internally, the phase is an unsigned 64-bit fixed-point number where the
+ * full 2^64 range is one cycle, so wrapping around is just integer overflow
+ * and advancing is exact integer math. Unlike a floating point phase, no
+ * rounding error builds up no matter how long we run. The only error is the
+ * one made when rounding the per-sample increment to 64 bits, which is at
+ * most 2^-64 cycles per sample (plus the error of frequency / sample rate
+ * itself). At 48 kHz that's well under 1e-8 cycles after 10^11 samples,
+ * or about 24 days of nonstop audio. That assumes a long double wider than
+ * double. Where it isn't (MSVC), the ratio's rounding dominates and the
+ * bound is closer to 6e-6 cycles. SKTremoloBench --check runs the 10^11
+ * samples in big jumps and compares against the exact phase.
+ *
+ * The whole state fits in a single cache line. It's meant to be owned by
+ * the audio thread and is NOT thread-safe. Plain members let the compiler
+ * keep the phase in registers and vectorize around it. Changes coming from
+ * other threads need to be handed over to the audio thread first (see
+ * TremoloAudioProcessor::applyOscillatorSettings()).
+ */
+class alignas(CacheLine::SIZE) PhaseAccumulator
+{
+public:
+
+    //! One full cycle in fixed point, 2^64.
+    static constexpr long double FIXED_POINT_ONE = 18446744073709551616.0L;
+
+    /**
+     * Constructor.
+     */
+    PhaseAccumulator() :
+        m_phase(0),
+        m_phaseIncrement(0),
+        m_sampleRate(0.0),
+        m_frequency(0.0)
+    {
+    }
+
+    /**
+     * Sets the audio stream sample rate.
+     *
+     * Note that if the sample rate is set to zero, the phase will never advance.
+     *
+     * @param sampleRate The new audio stream sample rate.
+     */
+    void setSampleRate(double sampleRate)
+    {
+        m_sampleRate = sampleRate;
+        recalculatePhaseDelta();
+    }
+
+    /**
+     * Sets the oscillation frequency.
+     *
+     * Note that if the frequency is set to zero, the phase will never advance.
+     *
+     * @param frequency The oscillation frequency in Hz.
+     */
+    void setFrequency(double frequency)
+    {
+        m_frequency = frequency;
+        recalculatePhaseDelta();
+    }
+
+    /**
+     * Returns the oscillation frequency in Hz.
+     */
+    double getFrequency() const { return m_frequency; }
+
+    /**
+     * Jumps straight to the given phase. Used when the phase is dictated by
+     * something else, such as the host's playhead.
+     *
+     * @param phase The new phase. Wrapped into 0.0 <= phase < 1.0.
+     */
+    void setPhase(double phase)
+    {
+        m_phase = toFixedPoint(phase - std::floor(phase));
+    }
+
+    /**
+     * Returns the current phase, 0.0 <= phase < 1.0.
+     */
+    double getPhase() const { return toDouble(m_phase); }
+
+    /**
+     * Returns how much the phase advances with every sample.
+     */
+    double getPhaseDelta() const { return toDouble(m_phaseIncrement); }
+
+    /**
+     * Advances the phase by the specified number of samples. This happens in
+     * constant time regardless of how many samples are skipped, and is exact.
+     * Unsigned overflow takes care of wrapping.
+     *
+     * @param numSamples The number of samples to advance by.
+     */
+    void advance(int numSamples)
+    {
+        m_phase += m_phaseIncrement * static_cast<uint64_t>(numSamples);
+    }
+
+    /**
+     * Jumps to where the phase would be after advancing the given number of
+     * samples from phase 0.0 at the current frequency. Exact, just like
+     * advance(), so it lands on the very same bits.
+     *
+     * @param numSamples The number of samples since phase 0.0.
+     */
+    void setPosition(uint64_t numSamples)
+    {
+        m_phase = m_phaseIncrement * numSamples;
+    }
+
+    /**
+     * Resets the phase back to the starting position.
+     */
+    void reset() { m_phase = 0; }
+
+    /**
+     * Converts a fixed-point phase (or phase delta) to 0.0 <= phase < 1.0.
+     * Only the top 53 bits fit in a double. Dropping the rest (rather than
+     * rounding) makes sure we never round up to 1.0.
+     */
+    static double toDouble(uint64_t fixedPointPhase)
+    {
+        return static_cast<double>(fixedPointPhase >> 11) * 0x1.0p-53;
+    }
+
+    /**
+     * Converts 0.0 <= phase <= 1.0 to fixed point. 1.0 wraps around to 0.0,
+     * since converting 2^64 to uint64_t is undefined. It turns up more often
+     * than you'd think: phase - std::floor(phase) rounds to 1.0 for tiny
+     * negative phases.
+     */
+    static uint64_t toFixedPoint(double phase)
+    {
+        const long double fixedPointPhase = static_cast<long double>(phase) * FIXED_POINT_ONE;
+        return (fixedPointPhase < FIXED_POINT_ONE) ? static_cast<uint64_t>(fixedPointPhase) : 0;
+    }
+
+    /**
+     * Returns the fixed-point change in phase that occurs with every sample
+     * at the given frequency and sample rate. Exposed so that code keeping
+     * many phases in arrays of its own (see TremoloBank) advances them
+     * exactly like we do.
+     *
+     * @param frequency The oscillation frequency in Hz.
+     * @param sampleRate The audio stream sample rate. Zero means the phase never advances.
+     */
+    static uint64_t calculateIncrement(double frequency, double sampleRate)
+    {
+        if ((sampleRate == 0.0) || (sampleRate == -0.0))
+            return 0;
+
+        // The increment is rounded to the nearest 2^-64 of a cycle. Where long
+        // double has more bits than double (x86 with GCC and Clang), the ratio
+        // itself is more accurate too.
+        long double cyclesPerSample = static_cast<long double>(frequency) / sampleRate;
+        cyclesPerSample -= std::floor(cyclesPerSample);
+        const long double increment = std::floor(cyclesPerSample * FIXED_POINT_ONE + 0.5L);
+        return (increment < FIXED_POINT_ONE) ? static_cast<uint64_t>(increment) : 0;
+    }
+
+private:
+
+    /**
+     * Recalculates the change in phase that occurs with every sample.
+     */
+    void recalculatePhaseDelta()
+    {
+        m_phaseIncrement = calculateIncrement(m_frequency, m_sampleRate);
+    }
+
+    uint64_t m_phase;          //!< Where the phase currently is, in fixed point.
+    uint64_t m_phaseIncrement; //!< The change in phase that occurs with every sample, in fixed point.
+    double m_sampleRate;       //!< The audio stream sample rate as set by the client.
+    double m_frequency;        //!< The oscillation frequency as set by the client.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhaseAccumulator)
+};
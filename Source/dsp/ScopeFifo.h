@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "common/CacheLine.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+/**
+ * Carries what the tremolo is doing over to the editor's scope: the
+ * modulation curve and the envelope of the output, one point every few
+ * milliseconds.
+ *
+ * The audio thread is the only writer and the message thread the only
+ * reader. Points go through a juce::AbstractFifo over a fixed array, so
+ * neither side ever allocates, locks, or waits on the other. If the editor
+ * falls behind, new points are dropped rather than old ones overwritten.
+ *
+ * Nothing is pushed unless the editor has turned the scope on. With the
+ * editor closed, all the audio thread pays is one relaxed atomic load per
+ * block.
+ *
+ * @since 2026 Oct 16
+ */
+class alignas(CacheLine::SIZE) ScopeFifo
+{
+public:
+
+    /**
+     * One point on the scope.
+     */
+    struct Point
+    {
+        float modulation = 0.0f; //!< The tremolo gain at the end of the point's stretch of samples (0.0 to 1.0).
+        float envelope = 0.0f;   //!< The peak output across all channels over those samples.
+    };
+
+    static constexpr int CAPACITY = 2048;                //!< The most points that can be waiting to be read.
+    static constexpr double POINTS_PER_SECOND = 250.0;   //!< How many points the audio thread pushes per second of audio.
+
+    /**
+     * Constructor.
+     */
+    ScopeFifo() = default;
+
+    /**
+     * Works out how many samples go into each point. Call it from
+     * prepareToPlay(), while the audio thread isn't running.
+     */
+    void prepare(double sampleRate)
+    {
+        m_samplesPerPoint = std::max(1, juce::roundToInt(sampleRate / POINTS_PER_SECOND));
+        m_samplesUntilNextPoint = m_samplesPerPoint;
+        m_peak = 0.0f;
+    }
+
+    /**
+     * Turns the scope on or off. The editor turns it on while it's open.
+     * Safe to call from any thread.
+     */
+    void setEnabled(bool isEnabled) { m_isEnabled.store(isEnabled, std::memory_order_relaxed); }
+
+    /**
+     * Returns true if the scope is on.
+     */
+    bool isEnabled() const { return m_isEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Pushes the points for one processed block, if the scope is on. Audio
+     * thread only.
+     *
+     * @param buffer The block, after processing.
+     * @param numChannels The number of channels that carry audio.
+     * @param modulationAt Returns the tremolo gain at a given sample in the block.
+     *        Only called once per point, so it doesn't need to be cheap.
+     */
+    template <typename FloatType, typename ModulationFunction>
+    void push(const juce::AudioBuffer<FloatType> &buffer, int numChannels, ModulationFunction &&modulationAt)
+    {
+        if (!isEnabled())
+            return;
+
+        const int numSamples = buffer.getNumSamples();
+        for (int position = 0; position < numSamples;)
+        {
+            const int numToScan = std::min(m_samplesUntilNextPoint, numSamples - position);
+            for (int channel = 0; channel < numChannels; ++channel)
+                m_peak = std::max(m_peak, static_cast<float>(buffer.getMagnitude(channel, position, numToScan)));
+
+            position += numToScan;
+            m_samplesUntilNextPoint -= numToScan;
+            if (m_samplesUntilNextPoint == 0)
+            {
+                write({ static_cast<float>(modulationAt(position - 1)), m_peak });
+                m_peak = 0.0f;
+                m_samplesUntilNextPoint = m_samplesPerPoint;
+            }
+        }
+    }
+
+    /**
+     * Moves up to maxPoints of the oldest waiting points into pPoints.
+     * Reader thread only.
+     *
+     * @return The number of points moved.
+     */
+    int pull(Point *pPoints, int maxPoints)
+    {
+        int numPulled = 0;
+        m_fifo.read(std::min(maxPoints, m_fifo.getNumReady())).forEach([&](int index)
+        {
+            pPoints[numPulled++] = m_points[static_cast<size_t>(index)];
+        });
+        return numPulled;
+    }
+
+    /**
+     * Throws away every waiting point. Reader thread only.
+     */
+    void discard() { m_fifo.read(m_fifo.getNumReady()); }
+
+private:
+
+    /**
+     * Adds a point, unless the reader has fallen so far behind there's no room.
+     */
+    void write(const Point &point)
+    {
+        if (m_fifo.getFreeSpace() == 0)
+            return;
+
+        m_fifo.write(1).forEach([&](int index) { m_points[static_cast<size_t>(index)] = point; });
+    }
+
+    // Audio thread only.
+    int m_samplesPerPoint = 1;       //!< Samples per point. Set in prepare().
+    int m_samplesUntilNextPoint = 1; //!< Samples left before the next point is pushed.
+    float m_peak = 0.0f;             //!< The peak output since the last point.
+
+    std::array<Point, CAPACITY> m_points;     //!< The points on their way to the reader.
+    juce::AbstractFifo m_fifo{ CAPACITY };    //!< Which of m_points are waiting to be read.
+
+    alignas(CacheLine::SIZE) std::atomic<bool> m_isEnabled{ false }; //!< Set by the editor. Written by another thread, so on a line of its own.
+
+    JUCE_DECLARE_NON_COPYABLE(ScopeFifo)
+};
@@ -0,0 +1,258 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "EnvelopeTable.h"
+#include "WaveShapes.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+
+#if JUCE_INTEL
+ #include <emmintrin.h>
+#endif
+
+/**
+ * How accurately SineKernel calculates the sine wave shape.
+ *
+ * The tremolo reads the sine back from an EnvelopeTable, whose linear
+ * interpolation adds an error of its own. Each tier gets a table big enough
+ * to keep that well below the polynomial's error. The bounds below are
+ * polynomial + table.
+ */
+enum class SinePrecision
+{
+    Fast,     //!< 5th order polynomial in single precision, 4 values at a time, 2048 point table. Max absolute error < 7e-5 + 1.2e-6.
+    Standard, //!< 7th order polynomial in single precision, 4 values at a time, 8192 point table. Max absolute error < 1e-6 + 7.4e-8.
+    High      //!< 9th order polynomial in double precision, 2 values at a time, 65536 point table. Max absolute error < 5e-9 + 1.2e-9.
+};
+
+/**
+ * A fast, vectorized replacement for WaveShapes::sine(). An LFO doesn't need
+ * anything close to the accuracy std::sin/std::cos give us, so we trade it
+ * for speed using odd minimax polynomials that approximate sin(2 * pi * z)
+ * over -0.25 <= z <= 0.25.
+ *
+ * The polynomial error bounds listed in SinePrecision were measured against
+ * std::cos by sweeping every phase in [0, 1) in steps of 1e-7. The table
+ * bounds come from EnvelopeTable::maxSineInterpolationError().
+ * SKTremoloBench --check runs the sweep again, with and without the table.
+ *
+ * The polynomials (and the SSE2 code below) only run when the processor
+ * builds its sine EnvelopeTable, on a background thread. Every block the
+ * tremolo renders reads the table instead. SKTremoloBench times both, so
+ * it's easy to see which one is cheaper per sample.
+ */
+namespace SineKernel
+{
+    //! Minimax coefficients for sin(2 * pi * z). Lowest order first.
+    constexpr float  FAST_COEFFS[]     = { 6.2812800766395f, -41.095242688673395f, 73.58551475358666f };
+    constexpr float  STANDARD_COEFFS[] = { 6.283164044302505f, -41.337142371122624f, 81.34076888869937f, -70.99343328277975f };
+    constexpr double HIGH_COEFFS[]     = { 6.2831851600894835, -41.34165503141761, 81.60100407334106, -76.54978229534504, 39.53670607844828 };
+
+    /**
+     * Returns the worst case absolute error of the given tier's polynomial.
+     */
+    constexpr double maxPolynomialError(SinePrecision precision)
+    {
+        return (precision == SinePrecision::Fast) ? 7e-5 :
+               (precision == SinePrecision::Standard) ? 1e-6 : 5e-9;
+    }
+
+    /**
+     * Returns the number of points in the EnvelopeTable the given tier is
+     * read back from. The High table takes 512 KB, and the processor keeps
+     * three of them, so it's only worth it for offline renders that really
+     * need it.
+     */
+    constexpr int getTableSize(SinePrecision precision)
+    {
+        return (precision == SinePrecision::Fast) ? 2048 :
+               (precision == SinePrecision::Standard) ? 8192 : 65536;
+    }
+
+    /**
+     * Returns the worst case absolute error of the given tier, as read back
+     * from its table.
+     */
+    constexpr double maxAbsoluteError(SinePrecision precision)
+    {
+        return maxPolynomialError(precision) + EnvelopeTable::maxSineInterpolationError(getTableSize(precision));
+    }
+
+    /**
+     * Evaluates an odd polynomial z * (c0 + c1 * z^2 + c2 * z^4 + ...).
+     */
+    template <typename FloatType, size_t numCoeffs>
+    inline FloatType evaluateOddPolynomial(FloatType z, const FloatType (&coeffs)[numCoeffs])
+    {
+        const FloatType z2 = z * z;
+        FloatType result = coeffs[numCoeffs - 1];
+        for (size_t i = numCoeffs - 1; i > 0; --i)
+            result = result * z2 + coeffs[i - 1];
+        return result * z;
+    }
+
+    /**
+     * Calculates the sine wave shape at the given phase (0.0 <= phase) using
+     * the given coefficients. Matches WaveShapes::sine() to within the error
+     * bound of the coefficients.
+     */
+    template <typename FloatType, size_t numCoeffs>
+    inline double value(double phase, const FloatType (&coeffs)[numCoeffs])
+    {
+        // -cos(2 * pi * phase) == sin(2 * pi * (phase - 0.25)). Bring the argument
+        // into [-0.5, 0.5). Since phase + 0.25 is never negative, truncating
+        // is the same as flooring.
+        double x = phase - 0.25;
+        x = x - static_cast<int>(phase + 0.25);
+
+        // sin(2 * pi * x) == sin(2 * pi * (+/-0.5 - x)), which lets us fold the
+        // argument into [-0.25, 0.25] where the polynomial is valid.
+        const FloatType fx = static_cast<FloatType>(x);
+        const FloatType ax = std::abs(fx);
+        const FloatType z = std::copysign(std::min(ax, static_cast<FloatType>(0.5) - ax), fx);
+        return static_cast<double>(evaluateOddPolynomial(z, coeffs));
+    }
+
+#if JUCE_INTEL
+    /**
+     * Evaluates an odd polynomial for 4 floats at once.
+     */
+    template <size_t numCoeffs>
+    inline __m128 evaluateOddPolynomial(__m128 z, const float (&coeffs)[numCoeffs])
+    {
+        const __m128 z2 = _mm_mul_ps(z, z);
+        __m128 result = _mm_set1_ps(coeffs[numCoeffs - 1]);
+        for (size_t i = numCoeffs - 1; i > 0; --i)
+            result = _mm_add_ps(_mm_mul_ps(result, z2), _mm_set1_ps(coeffs[i - 1]));
+        return _mm_mul_ps(result, z);
+    }
+
+    /**
+     * Evaluates an odd polynomial for 2 doubles at once.
+     */
+    template <size_t numCoeffs>
+    inline __m128d evaluateOddPolynomial(__m128d z, const double (&coeffs)[numCoeffs])
+    {
+        const __m128d z2 = _mm_mul_pd(z, z);
+        __m128d result = _mm_set1_pd(coeffs[numCoeffs - 1]);
+        for (size_t i = numCoeffs - 1; i > 0; --i)
+            result = _mm_add_pd(_mm_mul_pd(result, z2), _mm_set1_pd(coeffs[i - 1]));
+        return _mm_mul_pd(result, z);
+    }
+
+    /**
+     * Does the same range reduction as value() for 2 phases at once.
+     */
+    inline __m128d reduceArgument(__m128d phase)
+    {
+        const __m128d quarter = _mm_set1_pd(0.25);
+        const __m128d whole = _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_add_pd(phase, quarter)));
+        return _mm_sub_pd(_mm_sub_pd(phase, quarter), whole);
+    }
+
+    /**
+     * Renders 4 values at a time in single precision.
+     */
+    template <size_t numCoeffs>
+    inline int renderVectorized(double startPhase, double phaseDelta, double *pDest, int numValues, const float (&coeffs)[numCoeffs])
+    {
+        const __m128d start = _mm_set1_pd(startPhase);
+        const __m128d delta = _mm_set1_pd(phaseDelta);
+        const __m128d four = _mm_set1_pd(4.0);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        __m128d index01 = _mm_set_pd(1.0, 0.0);
+        __m128d index23 = _mm_set_pd(3.0, 2.0);
+
+        int i = 0;
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const __m128d x01 = reduceArgument(_mm_add_pd(start, _mm_mul_pd(delta, index01)));
+            const __m128d x23 = reduceArgument(_mm_add_pd(start, _mm_mul_pd(delta, index23)));
+            const __m128 x = _mm_movelh_ps(_mm_cvtpd_ps(x01), _mm_cvtpd_ps(x23));
+
+            const __m128 ax = _mm_andnot_ps(signMask, x);
+            const __m128 folded = _mm_min_ps(ax, _mm_sub_ps(half, ax));
+            const __m128 z = _mm_or_ps(folded, _mm_and_ps(x, signMask));
+
+            const __m128 result = evaluateOddPolynomial(z, coeffs);
+            _mm_storeu_pd(pDest + i, _mm_cvtps_pd(result));
+            _mm_storeu_pd(pDest + i + 2, _mm_cvtps_pd(_mm_movehl_ps(result, result)));
+
+            index01 = _mm_add_pd(index01, four);
+            index23 = _mm_add_pd(index23, four);
+        }
+
+        return i;
+    }
+
+    /**
+     * Renders 2 values at a time in double precision.
+     */
+    template <size_t numCoeffs>
+    inline int renderVectorized(double startPhase, double phaseDelta, double *pDest, int numValues, const double (&coeffs)[numCoeffs])
+    {
+        const __m128d start = _mm_set1_pd(startPhase);
+        const __m128d delta = _mm_set1_pd(phaseDelta);
+        const __m128d two = _mm_set1_pd(2.0);
+        const __m128d signMask = _mm_set1_pd(-0.0);
+        const __m128d half = _mm_set1_pd(0.5);
+        __m128d index = _mm_set_pd(1.0, 0.0);
+
+        int i = 0;
+        for (; i + 2 <= numValues; i += 2)
+        {
+            const __m128d x = reduceArgument(_mm_add_pd(start, _mm_mul_pd(delta, index)));
+
+            const __m128d ax = _mm_andnot_pd(signMask, x);
+            const __m128d folded = _mm_min_pd(ax, _mm_sub_pd(half, ax));
+            const __m128d z = _mm_or_pd(folded, _mm_and_pd(x, signMask));
+
+            _mm_storeu_pd(pDest + i, evaluateOddPolynomial(z, coeffs));
+
+            index = _mm_add_pd(index, two);
+        }
+
+        return i;
+    }
+#endif
+
+    /**
+     * Fills the provided buffer with sine wave shape values, starting at
+     * startPhase and advancing by phaseDelta with every value. Has the same
+     * signature as the renderers in WaveShapes so it can be used in their place.
+     *
+     * @param startPhase The phase of the first value. Must not be negative.
+     * @param phaseDelta How much the phase advances with every value. Must not be negative.
+     * @param pDest The buffer to fill. Must have room for at least numValues values.
+     * @param numValues The number of values to calculate.
+     */
+    template <typename FloatType, size_t numCoeffs, const FloatType (&coeffs)[numCoeffs]>
+    void renderBlock(double startPhase, double phaseDelta, double *pDest, int numValues)
+    {
+        int i = 0;
+#if JUCE_INTEL
+        i = renderVectorized(startPhase, phaseDelta, pDest, numValues, coeffs);
+#endif
+        for (; i < numValues; ++i)
+            pDest[i] = value(startPhase + phaseDelta * i, coeffs);
+    }
+
+    /**
+     * Returns the block renderer for the given precision tier.
+     */
+    inline WaveShapes::BlockRenderFunction getBlockRenderer(SinePrecision precision)
+    {
+        switch (precision)
+        {
+            case SinePrecision::Fast:     return &renderBlock<float, 3, FAST_COEFFS>;
+            case SinePrecision::High:     return &renderBlock<double, 5, HIGH_COEFFS>;
+            case SinePrecision::Standard:
+            default:                      return &renderBlock<float, 4, STANDARD_COEFFS>;
+        }
+    }
+}
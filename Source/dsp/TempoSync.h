@@ -0,0 +1,71 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "common/SyncDivisions.h"
+#include <juce_core/juce_core.h>
+#include <cmath>
+
+/**
+ * Musical time for the tremolo. When tempo sync is on, one oscillation lasts
+ * one note division (1/1 down to 1/64, straight, dotted, or triplet) at the
+ * host's tempo, instead of following the speed parameter. The divisions
+ * themselves are listed in SyncDivisions.
+ *
+ * Everything here is measured in quarter notes, the same unit the host uses
+ * for its ppq (pulses per quarter note) position. That lets us calculate the
+ * phase straight from the host's position, so seeks, loops, and offline
+ * bounces always land on the same phase.
+ */
+namespace TempoSync
+{
+    //! The tempo we assume until the host tells us otherwise.
+    constexpr double DEFAULT_BPM = 120.0;
+
+    /**
+     * Returns how many quarter notes the given division lasts.
+     *
+     * @param divisionIndex An index into SyncDivisions::getNames().
+     */
+    inline double getDivisionInQuarterNotes(int divisionIndex)
+    {
+        divisionIndex = juce::jlimit(0, SyncDivisions::NUM_DIVISIONS - 1, divisionIndex);
+        const double quarterNotes = 4.0 / SyncDivisions::NOTE_VALUES[divisionIndex / 3];
+
+        switch (static_cast<SyncDivisions::DivisionType>(divisionIndex % 3))
+        {
+            case SyncDivisions::DivisionType::Dotted:  return quarterNotes * 1.5;
+            case SyncDivisions::DivisionType::Triplet: return quarterNotes * 2.0 / 3.0;
+            case SyncDivisions::DivisionType::Straight:
+            default:                    return quarterNotes;
+        }
+    }
+
+    /**
+     * Returns the oscillation frequency in Hz for the given tempo and division.
+     *
+     * @param bpm The tempo in quarter notes per minute.
+     * @param divisionIndex An index into SyncDivisions::getNames().
+     */
+    inline double calculateFrequency(double bpm, int divisionIndex)
+    {
+        return (bpm / 60.0) / getDivisionInQuarterNotes(divisionIndex);
+    }
+
+    /**
+     * Returns the phase (0.0 <= phase < 1.0) at the given host position. The
+     * phase is 0.0 at the start of the song and at every multiple of the
+     * division after that.
+     *
+     * @param ppqPosition The host position in quarter notes.
+     * @param divisionIndex An index into SyncDivisions::getNames().
+     */
+    inline double calculatePhase(double ppqPosition, int divisionIndex)
+    {
+        const double cycles = ppqPosition / getDivisionInQuarterNotes(divisionIndex);
+        const double phase = cycles - std::floor(cycles);
+        return (phase < 1.0) ? phase : 0.0;
+    }
+}
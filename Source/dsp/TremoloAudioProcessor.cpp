@@ -4,6 +4,7 @@
 
 #include "dsp/TremoloAudioProcessor.h"
 #include "ui/TremoloAudioProcessorEditor.h"
+#include "common/Trace.h"
 
 /**
  * @since 2024 Oct 1
@@ -12,11 +13,13 @@ TremoloAudioProcessor::TremoloAudioProcessor()
     : AudioProcessor(BusesProperties()
                        .withInput("Input", juce::AudioChannelSet::stereo(), true)
                        .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
+      m_instructionSet(InstructionSets::select()),
       m_audioParams(this)
 {
     static_assert(std::atomic<int>::is_always_lock_free,
         "Cannot perform atomic operations on target platform without locking.");
     m_audioParams.addListener(this);
+    rebuildSineTable();
 }
 
 /**
@@ -30,16 +33,55 @@ TremoloAudioProcessor::~TremoloAudioProcessor()
 /**
  * @since 2024 Oct 1
  */
-void TremoloAudioProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlock*/)
+void TremoloAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    // We update ALL of our wave generators so the user can toggle between them
-    // all cleanly at runtime.
-    for (auto &spOscillator : m_oscillators)
-    {
-        spOscillator->setSampleRate(sampleRate);
-        spOscillator->setFrequency(*(m_audioParams.m_pSpeedParamInHz));
-        spOscillator->reset();
-    }
+    TREMOLO_TRACE_SCOPE("prepareToPlay");
+
+    // The headless tools process on the thread that prepares. Hosts mostly
+    // don't, so there the audio thread still sets its trace buffer up on its
+    // first block.
+    TREMOLO_TRACE_PREPARE_THREAD();
+
+    // Hosts are allowed to send us blocks bigger than this. processBlock() will
+    // split those up into chunks that fit.
+    m_tremoloValues.resize(static_cast<size_t>(std::max(samplesPerBlock, 1)));
+    m_rightTremoloValues.resize(m_tremoloValues.size());
+
+    // The audio thread isn't running right now, so it's safe to touch its
+    // state directly.
+    m_phaseAccumulator.setSampleRate(sampleRate);
+    m_speedChanged = true;
+    applyOscillatorSettings();
+    m_phaseAccumulator.reset();
+
+    m_depth.reset(sampleRate, PARAMETER_RAMP_SECONDS);
+    m_depth.setCurrentAndTargetValue(*m_audioParams.m_pDepthParamInPercent);
+    m_gain.reset(sampleRate, PARAMETER_RAMP_SECONDS);
+    m_gain.setCurrentAndTargetValue(*m_audioParams.m_pGainParamInPercent);
+    m_bypassMix.reset(sampleRate, BYPASS_RAMP_SECONDS);
+    m_bypassMix.setCurrentAndTargetValue(*m_audioParams.m_pBypass ? 1.0 : 0.0);
+    m_spread.reset(sampleRate, PARAMETER_RAMP_SECONDS);
+    m_spread.setCurrentAndTargetValue(*m_audioParams.m_pSpreadParamInDegrees / 360.0);
+
+    m_silentSamples = 0;
+    m_silenceHoldSamples = static_cast<juce::int64>(sampleRate * SILENCE_HOLD_SECONDS);
+
+    m_performanceMonitor.prepare(sampleRate);
+    m_scopeFifo.prepare(sampleRate);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloAudioProcessor::seek(juce::int64 samplePosition)
+{
+    // The frequency has to be the one the blocks will run at. With tempo sync
+    // and a playing host, the next block takes the phase from the host anyway.
+    applyOscillatorSettings();
+    applyTempoSync();
+    m_phaseAccumulator.setPosition(static_cast<uint64_t>(std::max<juce::int64>(samplePosition, 0)));
+
+    m_silentSamples = 0;
 }
 
 /**
@@ -47,12 +89,10 @@ void TremoloAudioProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlo
  */
 bool TremoloAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const
 {
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Every channel gets the same tremolo, so we don't care what the channels
+    // are. Mono, stereo, 5.1, 7.1.4, ambisonics of any order, or a bunch of
+    // discrete channels all work the same way.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
     // This checks if the input layout matches the output layout
@@ -67,6 +107,41 @@ bool TremoloAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts) c
  */
 void TremoloAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &/*midiMessages*/)
 {
+    processSamples(buffer, false);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloAudioProcessor::processBlock(juce::AudioBuffer<double> &buffer, juce::MidiBuffer &/*midiMessages*/)
+{
+    processSamples(buffer, false);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloAudioProcessor::processBlockBypassed(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &/*midiMessages*/)
+{
+    processSamples(buffer, true);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloAudioProcessor::processBlockBypassed(juce::AudioBuffer<double> &buffer, juce::MidiBuffer &/*midiMessages*/)
+{
+    processSamples(buffer, true);
+}
+
+/**
+ * @since 2024 Oct 1
+ */
+template <typename FloatType>
+void TremoloAudioProcessor::processSamples(juce::AudioBuffer<FloatType> &buffer, bool hostBypassed)
+{
+    TREMOLO_TRACE_SCOPE("processBlock");
+    const PerformanceMonitor::ScopedBlock timing(m_performanceMonitor, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -80,18 +155,206 @@ void TremoloAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer, juce:
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // The magic
-    for (auto sampleIndex = 0; sampleIndex < buffer.getNumSamples(); ++sampleIndex)
+    if (m_tremoloValues.empty())
     {
-        float* const* channelPointers = buffer.getArrayOfWritePointers();
+        jassertfalse; // prepareToPlay() hasn't been called.
+        return;
+    }
+
+    applyOscillatorSettings();
+    applyTempoSync();
+    const double startPhase = m_phaseAccumulator.getPhase();
+
+    // Depth, gain, and spread are read once per block. Any change is ramped in
+    // over the following samples to avoid zipper noise.
+    m_depth.setTargetValue(*m_audioParams.m_pDepthParamInPercent);
+    m_gain.setTargetValue(*m_audioParams.m_pGainParamInPercent);
+    m_spread.setTargetValue(*m_audioParams.m_pSpreadParamInDegrees / 360.0);
+    m_bypassMix.setTargetValue((hostBypassed || *m_audioParams.m_pBypass) ? 1.0 : 0.0);
+
+    FloatType* const* channelPointers = buffer.getArrayOfWritePointers();
+    const int numSamples = buffer.getNumSamples();
+
+    if (updateSilenceHold(buffer, totalNumInputChannels))
+    {
+        // Nothing but silence for a while now. The tremolo would only turn it
+        // into more silence, so we leave it alone and just keep the oscillator
+        // and ramps moving. Both are O(1).
+        m_depth.skip(numSamples);
+        m_gain.skip(numSamples);
+        m_bypassMix.skip(numSamples);
+        m_spread.skip(numSamples);
+        m_phaseAccumulator.advance(numSamples);
+        pushScopePoints(buffer, totalNumInputChannels, startPhase);
+        return;
+    }
+
+    LfoBlockSettings settings;
+    settings.shapeIndex = getSelectedShapeIndex();
+
+    // The sine shape may be calculated at control rate, but only if the speed
+    // and sample rate leave room for interpolating without audible error.
+    if (settings.shapeIndex == 0)
+    {
+        settings.interpolation = m_lfoInterpolation;
+        settings.controlInterval = ControlRateLfo::chooseInterval(settings.interpolation, m_phaseAccumulator.getPhaseDelta(),
+            m_sineTables.getReadBuffer().getSize());
+        if (settings.controlInterval == 1)
+            settings.interpolation = LfoInterpolation::None;
+    }
+
+    // The spread only means something for a stereo pair. Everything else
+    // gets the same tremolo on every channel.
+    settings.isStereoSpread = (totalNumInputChannels == 2)
+        && (m_spread.isSmoothing() || m_spread.getCurrentValue() != 0.0);
+
+    if (m_depth.isSmoothing() || m_gain.isSmoothing() || m_bypassMix.isSmoothing()
+     || (settings.isStereoSpread && m_spread.isSmoothing()))
+    {
+        // Something is on the move. We calculate a whole chunk of tremolo
+        // values up front and then apply them to each channel.
+        const int maxChunkSize = static_cast<int>(m_tremoloValues.size());
+        double *pTremoloValues = m_tremoloValues.data();
+        double *pRightTremoloValues = m_rightTremoloValues.data();
+
+        for (int chunkStart = 0; chunkStart < numSamples; chunkStart += maxChunkSize)
+        {
+            const int chunkSize = std::min(maxChunkSize, numSamples - chunkStart);
+            calculateTremoloEffectValues(settings, pTremoloValues, pRightTremoloValues, chunkSize);
+
+            if (settings.isStereoSpread)
+            {
+                TremoloKernels::applyModulation(pTremoloValues, channelPointers, 1, chunkStart, chunkSize);
+                TremoloKernels::applyModulation(pRightTremoloValues, channelPointers + 1, 1, chunkStart, chunkSize);
+            }
+            else
+            {
+                TremoloKernels::applyModulation(pTremoloValues, channelPointers, totalNumInputChannels, chunkStart, chunkSize);
+            }
+        }
+        pushScopePoints(buffer, totalNumInputChannels, startPhase);
+        return;
+    }
+
+    // Only stereo pairs ramp the spread. Everyone else just lets it settle.
+    m_spread.skip(numSamples);
+
+    // From here on, everything is constant for this block. The oscillator
+    // keeps running no matter what, so it's in the right place when it's
+    // needed again. Advancing it is O(1).
+    double scale = 0.0;
+    double offset = 0.0;
+    TremoloKernels::calculateScaleAndOffset(m_depth.getCurrentValue(), m_gain.getCurrentValue(), scale, offset);
+
+    if (m_bypassMix.getCurrentValue() == 1.0)
+    {
+        // Bypassed. The audio passes through untouched.
+    }
+    else if (scale == 0.0)
+    {
+        // Depth or gain is 0, which leaves nothing to oscillate. The tremolo is
+        // just a constant gain, if anything at all.
+        applyConstantGain(buffer, totalNumInputChannels, offset);
+    }
+    else if (totalNumInputChannels > 0)
+    {
+        // The magic. A single kernel specialized for the wave shape and channel
+        // layout does all the work.
+        TremoloKernels::BlockContext<FloatType> context;
+        context.pChannels = channelPointers;
+        context.numChannels = totalNumInputChannels;
+        context.numSamples = numSamples;
+        context.startPhase = m_phaseAccumulator.getPhase();
+        context.phaseDelta = m_phaseAccumulator.getPhaseDelta();
+        context.pSineTable = &m_sineTables.getReadBuffer();
+        context.pScratch = m_tremoloValues.data();
+        context.pRightScratch = m_rightTremoloValues.data();
+        context.scratchSize = static_cast<int>(m_tremoloValues.size());
+        context.controlInterval = settings.controlInterval;
+        context.rightPhaseOffset = settings.isStereoSpread ? m_spread.getCurrentValue() : 0.0;
+        context.scale = scale;
+        context.offset = offset;
+
+        TremoloKernels::getKernel<FloatType>(m_instructionSet, settings.shapeIndex, context, settings.interpolation)(context);
+    }
+
+    m_phaseAccumulator.advance(numSamples);
+    pushScopePoints(buffer, totalNumInputChannels, startPhase);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+template <typename FloatType>
+bool TremoloAudioProcessor::updateSilenceHold(const juce::AudioBuffer<FloatType> &buffer, int numChannels)
+{
+    const int numSamples = buffer.getNumSamples();
+
+    if (!buffer.hasBeenCleared())
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            if (buffer.getMagnitude(channel, 0, numSamples) > static_cast<FloatType>(SILENCE_THRESHOLD))
+            {
+                m_silentSamples = 0;
+                return false;
+            }
+        }
+    }
+
+    m_silentSamples += numSamples;
+    return m_silentSamples > m_silenceHoldSamples;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+template <typename FloatType>
+void TremoloAudioProcessor::pushScopePoints(const juce::AudioBuffer<FloatType> &buffer, int numChannels, double startPhase)
+{
+    if (!m_scopeFifo.isEnabled())
+        return;
 
-        double tremoloValue = calculateTremoloEffectValue();
-        for (auto channel = 0; channel < totalNumInputChannels; ++channel)
+    // The scope only needs a handful of points per block, so rather than
+    // keep the values the kernels calculated, we calculate the few we need
+    // again. Depth, gain, and the bypass crossfade are taken as they are at
+    // the end of the block, which is close enough for a picture.
+    const size_t shapeIndex = getSelectedShapeIndex();
+    const EnvelopeTable &sineTable = m_sineTables.getReadBuffer();
+    const double phaseDelta = m_phaseAccumulator.getPhaseDelta();
+    const double depth = m_depth.getCurrentValue();
+    const double gain = m_gain.getCurrentValue();
+    const double bypassMix = m_bypassMix.getCurrentValue();
+
+    m_scopeFifo.push(buffer, numChannels, [&](int sampleIndex)
+    {
+        const double phase = TremoloKernels::wrapPhase(startPhase + phaseDelta * sampleIndex);
+        double shapeValue = 0.0;
+        switch (shapeIndex)
         {
-            float* pChannelValue = channelPointers[channel] + sampleIndex;
-            double newValue = static_cast<double>(*pChannelValue) * tremoloValue;
-            *pChannelValue = static_cast<float>(newValue);
+            case 1: shapeValue = TremoloKernels::SquareShape::value(sineTable, phase); break;
+            case 2: shapeValue = TremoloKernels::TriangleShape::value(sineTable, phase); break;
+            default: shapeValue = TremoloKernels::SineShape::value(sineTable, phase); break;
         }
+        return calculateTremoloEffectValue(shapeValue, depth, gain, bypassMix);
+    });
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+template <typename FloatType>
+void TremoloAudioProcessor::applyConstantGain(juce::AudioBuffer<FloatType> &buffer, int numChannels, double gain)
+{
+    if (gain == 1.0)
+        return;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        if (gain == 0.0)
+            buffer.clear(channel, 0, buffer.getNumSamples());
+        else
+            buffer.applyGain(channel, 0, buffer.getNumSamples(), static_cast<FloatType>(gain));
     }
 }
 
@@ -100,7 +363,7 @@ void TremoloAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer, juce:
  */
 juce::AudioProcessorEditor *TremoloAudioProcessor::createEditor()
 {
-    return new TremoloAudioProcessorEditor(*this, m_audioParams);
+    return new TremoloAudioProcessorEditor(*this, m_audioParams, m_performanceMonitor, m_scopeFifo);
 }
 
 /**
@@ -108,48 +371,185 @@ juce::AudioProcessorEditor *TremoloAudioProcessor::createEditor()
  */
 void TremoloAudioProcessor::parameterValueChanged(int parameterIndex, float newValue)
 {
+    TREMOLO_TRACE_SCOPE("parameterValueChanged");
+
     switch (parameterIndex)
     {
         case 0:
         {
-            // We update ALL of our wave generators so the user can toggle between them
-            // all cleanly at runtime.
-            for (auto &spOscillator : m_oscillators)
-            {
-                spOscillator->setFrequency(*m_audioParams.m_pSpeedParamInHz);
-            }
+            // This may be the audio thread, so don't do anything that could
+            // block. The next block picks the new speed up.
+            m_speedChanged.store(true, std::memory_order_release);
             break;
         }
-        case 1: break; // Depth changes are picked up automatically as part of the stream processing.
-        case 2: break; // Gain changes are picked up automatically as part of the stream processing.
-        case 3: break; // Oscillator changes are picked up automatically as part of the stream processing.
+        case 1: break; // Depth changes are picked up at the start of every block.
+        case 2: break; // Gain changes are picked up at the start of every block.
+        case 3: break; // Oscillator changes are picked up at the start of every block.
+        case 4: break; // Bypass changes are picked up at the start of every block.
+        case 5: break; // Spread changes are picked up at the start of every block.
+        case 6: break; // Tempo sync changes are picked up at the start of every block.
+        case 7: break; // Division changes are picked up at the start of every block.
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloAudioProcessor::applyOscillatorSettings()
+{
+    // Clearing the flag before reading the parameter means a change that
+    // lands in between is either read now or sets the flag again.
+    if (!m_speedChanged.exchange(false, std::memory_order_acquire))
+        return;
+
+    const double frequency = *m_audioParams.m_pSpeedParamInHz;
+    m_phaseAccumulator.setFrequency(frequency);
+    m_freeRunningFrequency = frequency;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloAudioProcessor::applyTempoSync()
+{
+    double frequency = m_freeRunningFrequency;
+
+    if (*m_audioParams.m_pTempoSync)
+    {
+        const int divisionIndex = m_audioParams.m_pSyncDivision->getIndex();
+
+        juce::Optional<juce::AudioPlayHead::PositionInfo> position;
+        if (juce::AudioPlayHead *pPlayHead = getPlayHead())
+            position = pPlayHead->getPosition();
+
+        if (position.hasValue())
+            m_hostBpm = position->getBpm().orFallback(m_hostBpm);
+        frequency = TempoSync::calculateFrequency(m_hostBpm, divisionIndex);
+
+        // While the host is playing, the phase comes straight from its position
+        // rather than being accumulated, so it can't drift and lands in the
+        // same place no matter where playback started. While it's stopped, we
+        // just keep going at the host's tempo.
+        if (position.hasValue() && position->getIsPlaying())
+        {
+            if (const auto ppqPosition = position->getPpqPosition())
+                m_phaseAccumulator.setPhase(TempoSync::calculatePhase(*ppqPosition, divisionIndex));
+        }
+    }
+
+    if (frequency != m_phaseAccumulator.getFrequency())
+        m_phaseAccumulator.setFrequency(frequency);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+size_t TremoloAudioProcessor::getSelectedShapeIndex() const
+{
+    const int oscillatorIndex = m_audioParams.m_pOscillatorType->getIndex();
+    return static_cast<size_t>(juce::jlimit(0, 2, oscillatorIndex));
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloAudioProcessor::rebuildSineTable()
+{
+    m_sineTableDirty = true;
+
+    // Only one thread gets to build at a time. If some other thread is already
+    // building, it'll notice the dirty flag and pick up our change too, so
+    // there's no need for us to wait around.
+    while (m_sineTableDirty)
+    {
+        const juce::SpinLock::ScopedTryLockType lock(m_sineTableBuildLock);
+        if (!lock.isLocked())
+            return;
+
+        while (m_sineTableDirty.exchange(false))
+        {
+            const SinePrecision precision = m_sinePrecision;
+            m_sineTables.getWriteBuffer().build(SineKernel::getBlockRenderer(precision), SineKernel::getTableSize(precision));
+            m_sineTables.publish();
+        }
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloAudioProcessor::renderShapeValues(const LfoBlockSettings &settings, double startPhase, double phaseDelta,
+    double *pValues, int numValues)
+{
+    if (settings.interpolation != LfoInterpolation::None)
+    {
+        TremoloKernels::getControlRateRenderer(m_instructionSet, settings.interpolation)(m_sineTables.getReadBuffer(),
+            startPhase, phaseDelta, settings.controlInterval, pValues, numValues);
+    }
+    else
+    {
+        TremoloKernels::getShapeRenderer(m_instructionSet, settings.shapeIndex)(m_sineTables.getReadBuffer(),
+            startPhase, phaseDelta, pValues, numValues);
     }
 }
 
 /**
  * @since 2024 Oct 11
  */
-double TremoloAudioProcessor::calculateTremoloEffectValue() const
+void TremoloAudioProcessor::calculateTremoloEffectValues(const LfoBlockSettings &settings, double *pValues,
+    double *pRightValues, int numValues)
 {
-    double effectValue = 0.0;
-    int oscillatorIndex = *m_audioParams.m_pOscillatorType;
-    for (size_t i = 0; i < m_oscillators.size(); ++i)
+    // All wave shapes share the same phase, so the user can toggle between
+    // them cleanly at runtime.
+    const double startPhase = m_phaseAccumulator.getPhase();
+    const double phaseDelta = m_phaseAccumulator.getPhaseDelta();
+    renderShapeValues(settings, startPhase, phaseDelta, pValues, numValues);
+
+    if (settings.isStereoSpread)
     {
-        if (i == oscillatorIndex)
-            effectValue = m_oscillators[i]->nextValue();
-        else
-            m_oscillators[i]->skipNextValue();
+        // The right channel runs ahead of the left by the spread. A ramping
+        // spread is the same as the right channel running at a slightly
+        // different speed for the length of this chunk. Starting a whole
+        // period ahead keeps its phase from going negative while the spread
+        // shrinks.
+        const double startOffset = m_spread.getCurrentValue();
+        const double endOffset = m_spread.skip(numValues);
+        const double rightStartPhase = TremoloKernels::wrapPhase(startPhase + startOffset) + 1.0;
+        const double rightPhaseDelta = phaseDelta + (endOffset - startOffset) / numValues;
+        renderShapeValues(settings, rightStartPhase, rightPhaseDelta, pRightValues, numValues);
+    }
+    else
+    {
+        m_spread.skip(numValues);
     }
 
+    m_phaseAccumulator.advance(numValues);
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        const double depth = m_depth.getNextValue();
+        const double gain = m_gain.getNextValue();
+        const double bypassMix = m_bypassMix.getNextValue();
+
+        pValues[i] = calculateTremoloEffectValue(pValues[i], depth, gain, bypassMix);
+        if (settings.isStereoSpread)
+            pRightValues[i] = calculateTremoloEffectValue(pRightValues[i], depth, gain, bypassMix);
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+double TremoloAudioProcessor::calculateTremoloEffectValue(double shapeValue, double depth, double gain, double bypassMix)
+{
     // We currently have a value between -1.0 and 1.0. Let's convert it to
     // a percentage it's between 0.0 and 1.0.
-    effectValue = (effectValue + 1.0) * 0.5;
+    double effectValue = (shapeValue + 1.0) * 0.5;
 
-    // Now let's apply the depth value.
-    if (*m_audioParams.m_pDepthParamInPercent < 1.0)
-        effectValue = effectValue * (*m_audioParams.m_pDepthParamInPercent) + (1.0 - *m_audioParams.m_pDepthParamInPercent);
+    // Now let's apply the depth value and then the user provided gain value.
+    const double tremoloValue = (effectValue * depth + (1.0 - depth)) * gain;
 
-    // Now finally the user provided gain value.
-    effectValue *= *m_audioParams.m_pGainParamInPercent;
-    return effectValue;
+    // The tremolo is just a gain, so crossfading to the dry signal is the
+    // same as crossfading the gain to 1.0.
+    return tremoloValue + (1.0 - tremoloValue) * bypassMix;
 }
@@ -4,12 +4,22 @@
 
 #pragma once
 
-#include "dsp/SineWaveOscillator.h"
-#include "dsp/TriangleWaveOscillator.h"
-#include "dsp/SquareWaveOscillator.h"
+#include "dsp/ControlRateLfo.h"
+#include "dsp/EnvelopeTable.h"
+#include "dsp/InstructionSet.h"
+#include "dsp/PerformanceMonitor.h"
+#include "dsp/PhaseAccumulator.h"
+#include "dsp/ScopeFifo.h"
+#include "dsp/SineKernel.h"
+#include "dsp/TempoSync.h"
+#include "dsp/TremoloKernels.h"
+#include "dsp/WaveShapes.h"
 #include "common/AudioParams.h"
+#include "common/CacheLine.h"
+#include "common/TripleBuffer.h"
 
 #include <JuceHeader.h>
+#include <vector>
 
 /**
  * The workhorse of the plugin. Implements the Tremolo effect.
@@ -45,9 +55,8 @@ public:
 
     /**
      * Lets the framework/host know what sort of bus layouts we support.
-     * We only support mono and stereo layouts, and the layouts must be
-     * consistent such that the input layout should match that of the
-     * output layout.
+     * We support any layout, discrete or ambisonic, as long as the input
+     * layout matches the output layout.
      */
     bool isBusesLayoutSupported(const BusesLayout &layouts) const override;
 
@@ -57,6 +66,35 @@ public:
      */
     void processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiMessages) override;
 
+    /**
+     * Processes the next block of audio in double precision. Hosts with a 64-bit
+     * mix bus call this instead of the float version so they don't have to
+     * convert our buffers back and forth.
+     */
+    void processBlock(juce::AudioBuffer<double> &buffer, juce::MidiBuffer &midiMessages) override;
+
+    /**
+     * Called by hosts instead of processBlock() while the plugin is bypassed.
+     * Passes the audio through untouched, after a short crossfade.
+     */
+    void processBlockBypassed(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiMessages) override;
+
+    /**
+     * Double precision version of processBlockBypassed().
+     */
+    void processBlockBypassed(juce::AudioBuffer<double> &buffer, juce::MidiBuffer &midiMessages) override;
+
+    /**
+     * Returns our bypass parameter so hosts can bypass us through it rather
+     * than through their own bypass.
+     */
+    juce::AudioProcessorParameter *getBypassParameter() const override { return m_audioParams.m_pBypass; }
+
+    /**
+     * Lets the host know we can process double precision audio natively.
+     */
+    bool supportsDoublePrecisionProcessing() const override { return true; }
+
     /**
      * Creates an instance of the editor UI. The JUCE framework takes ownership
      * of the object and deallocates it at the appropriate time.
@@ -111,8 +149,9 @@ public:
     /**
      * Returns the tail in seconds produced by the processor. For example,
      * if we were implementing a reverb, this might produce extra data at
-     * the end of the stream. We don't have that with a tremolo effect,
-     * so no need to worry about it here.
+     * the end of the stream. We don't have that with a tremolo effect.
+     * Silence in means silence out, which lets hosts that suspend plugins
+     * on silent tracks stop calling us right away.
      */
     double getTailLengthSeconds() const override { return 0.0; }
 
@@ -145,6 +184,86 @@ public:
      */
     void changeProgramName(int /*index*/, const juce::String &/*newName*/) override {}
 
+    /**
+     * Returns the plugin's parameters, for code that mirrors them elsewhere
+     * (see TremoloBank::VoiceSettings::fromParameters()).
+     */
+    const AudioParameters &getAudioParameters() const { return m_audioParams; }
+
+    /**
+     * Sets how accurately the sine wave shape is calculated. Defaults to
+     * SinePrecision::Standard, which is more than enough for an LFO. The
+     * render tool sets it with --sine-precision.
+     */
+    void setSinePrecision(SinePrecision precision) { m_sinePrecision = precision; rebuildSineTable(); }
+
+    /**
+     * Returns how accurately the sine wave shape is calculated.
+     */
+    SinePrecision getSinePrecision() const { return m_sinePrecision; }
+
+    /**
+     * Lets the sine wave shape be evaluated at control rate and interpolated
+     * in between, which saves a lot of CPU at high sample rates. Defaults to
+     * LfoInterpolation::None (audio rate). The render tool sets it with
+     * --lfo-interpolation. See ControlRateLfo.
+     */
+    void setLfoInterpolation(LfoInterpolation interpolation) { m_lfoInterpolation = interpolation; }
+
+    /**
+     * Returns how the sine wave shape is evaluated between control points.
+     */
+    LfoInterpolation getLfoInterpolation() const { return m_lfoInterpolation; }
+
+    /**
+     * Puts the oscillator exactly where it would be after processing
+     * samplePosition samples since prepareToPlay(). Lets an offline render be
+     * split into chunks that are processed independently (see
+     * ParallelRenderer). Call it after prepareToPlay(), on the thread that
+     * calls processBlock().
+     *
+     * The silence hold depends on the audio itself, so it starts over. To
+     * pick up exactly where an uninterrupted render would be, seek to
+     * getSeekPreRollSamples() (rounded up to whole blocks) before the
+     * position and process that audio first, throwing the output away.
+     * From then on, every block comes out bit for bit the same as an
+     * uninterrupted render, as long as the blocks start on the same samples
+     * and no parameter changes.
+     *
+     * @param samplePosition The number of samples since prepareToPlay().
+     */
+    void seek(juce::int64 samplePosition);
+
+    /**
+     * Returns how many samples of audio must be processed after a seek() for
+     * the processor to catch up with an uninterrupted render.
+     */
+    juce::int64 getSeekPreRollSamples() const { return m_silenceHoldSamples + 1; }
+
+    /**
+     * Turns a raw shape value (-1.0 to 1.0) into a tremolo effect value.
+     * Public so the benchmarks can time it on its own.
+     */
+    static double calculateTremoloEffectValue(double shapeValue, double depth, double gain, double bypassMix);
+
+    /**
+     * Returns the block timing counters. The editor shows them on a hidden
+     * page, to tell our dropouts apart from the host's.
+     */
+    PerformanceMonitor &getPerformanceMonitor() { return m_performanceMonitor; }
+
+    /**
+     * Returns the points for the editor's scope. Nothing is pushed until the
+     * editor turns it on.
+     */
+    ScopeFifo &getScopeFifo() { return m_scopeFifo; }
+
+    /**
+     * Returns the instruction set our DSP kernels run with. It's picked once,
+     * when the processor is created. See InstructionSets::select().
+     */
+    InstructionSet getInstructionSet() const { return m_instructionSet; }
+
     /*************************************************************************
      AudioProcessorParameter::Listener overrides.
      *************************************************************************/
@@ -164,19 +283,152 @@ public:
 private:
 
     /**
-     * Calculates the next tremolo effect value that should be applied to sample data
-     * for all channels.
+     * Does the actual work for the processBlock() and processBlockBypassed()
+     * overloads.
+     *
+     * @param buffer The audio to process in place.
+     * @param hostBypassed True if the host called processBlockBypassed().
      */
-    double calculateTremoloEffectValue() const;
+    template <typename FloatType>
+    void processSamples(juce::AudioBuffer<FloatType> &buffer, bool hostBypassed);
 
-    //! The supported oscillators.
-    std::array<std::unique_ptr<Oscillator>, 3> m_oscillators = 
-    { 
-        std::make_unique<SineWaveOscillator>(),
-        std::make_unique<SquareWaveOscillator>(),
-        std::make_unique<TriangleWaveOscillator>()
+    /**
+     * Checks whether the first numChannels channels of the buffer are silent
+     * and keeps track of how long they've been silent.
+     *
+     * @return True if the input has been silent for longer than SILENCE_HOLD_SECONDS.
+     */
+    template <typename FloatType>
+    bool updateSilenceHold(const juce::AudioBuffer<FloatType> &buffer, int numChannels);
+
+    /**
+     * Applies a constant gain to the first numChannels channels of the buffer.
+     * Does nothing at all for a gain of 1.0 and simply clears the channels for
+     * a gain of 0.0.
+     */
+    template <typename FloatType>
+    static void applyConstantGain(juce::AudioBuffer<FloatType> &buffer, int numChannels, double gain);
+
+    /**
+     * Pushes the scope's points for a processed block, if the editor is
+     * showing the scope.
+     *
+     * @param buffer The block, after processing.
+     * @param numChannels The number of channels that carry audio.
+     * @param startPhase The oscillator's phase at the first sample of the block.
+     */
+    template <typename FloatType>
+    void pushScopePoints(const juce::AudioBuffer<FloatType> &buffer, int numChannels, double startPhase);
+
+    /**
+     * Everything about the oscillator that's fixed for the length of a block.
+     */
+    struct LfoBlockSettings
+    {
+        size_t shapeIndex = 0;                                   //!< The selected wave shape.
+        LfoInterpolation interpolation = LfoInterpolation::None; //!< Anything but None calculates the sine shape at control rate.
+        int controlInterval = 1;                                 //!< The control interval, if interpolating. See ControlRateLfo::chooseInterval().
+        bool isStereoSpread = false;                             //!< True if the right channel of a stereo pair runs ahead of the left.
     };
 
+    /**
+     * Picks up the speed parameter if it has changed since the last block.
+     * Audio thread only.
+     *
+     * parameterValueChanged() can be called on any thread, the audio thread
+     * included, so all it does is set m_speedChanged. The parameter itself is
+     * an atomic, so there's nothing else to hand over and neither side ever
+     * locks. The sample rate only changes in prepareToPlay(), while the audio
+     * thread isn't running, so it's set directly there.
+     */
+    void applyOscillatorSettings();
+
+    /**
+     * Locks the oscillator to the host's tempo and position if tempo sync is
+     * on, or puts it back on the speed parameter if it isn't. Audio thread only.
+     */
+    void applyTempoSync();
+
+    /**
+     * Returns the index of the selected wave shape (0 = sine, 1 = square,
+     * 2 = triangle).
+     */
+    size_t getSelectedShapeIndex() const;
+
+    /**
+     * Rebuilds the cached sine table at the current sine precision and hands
+     * it over to the audio thread. Safe to call from any thread.
+     */
+    void rebuildSineTable();
+
+    /**
+     * Fills the provided buffer with raw shape values (-1.0 to 1.0), starting
+     * at startPhase and advancing by phaseDelta with every value.
+     */
+    void renderShapeValues(const LfoBlockSettings &settings, double startPhase, double phaseDelta,
+        double *pValues, int numValues);
+
+    /**
+     * Calculates the next numValues tremolo effect values that should be applied
+     * to sample data for all channels, ramping depth, gain, spread, and the
+     * bypass crossfade along the way.
+     *
+     * @param settings The oscillator settings for this block.
+     * @param pValues The buffer to fill. Must have room for at least numValues values.
+     * @param pRightValues The buffer to fill with the right channel's values
+     *        for a stereo spread. Must have room for at least numValues values.
+     * @param numValues The number of values to calculate.
+     */
+    void calculateTremoloEffectValues(const LfoBlockSettings &settings, double *pValues, double *pRightValues,
+        int numValues);
+
+    const InstructionSet m_instructionSet; //!< The instruction set our DSP kernels run with.
+
+    // What follows is written on the audio thread only. It starts on a cache
+    // line of its own (PhaseAccumulator is aligned to one), so nothing other
+    // threads write ever shares a line with it.
+
+    PhaseAccumulator m_phaseAccumulator; //!< The one phase all wave shapes are calculated from. Owned by the audio thread.
+
+    double m_freeRunningFrequency = 0.0;       //!< The speed parameter, as last applied on the audio thread.
+    double m_hostBpm = TempoSync::DEFAULT_BPM; //!< The host's tempo, as of the last block it told us.
+
+    juce::SmoothedValue<double> m_depth; //!< Depth parameter, read once per block and ramped per sample.
+    juce::SmoothedValue<double> m_gain;  //!< Gain parameter, read once per block and ramped per sample.
+    juce::SmoothedValue<double> m_spread; //!< Spread parameter as a phase offset (0.0 to 0.5), read once per block and ramped per sample.
+
+    juce::SmoothedValue<double> m_bypassMix; //!< 0.0 is fully processed, 1.0 is fully bypassed.
+
+    static constexpr double PARAMETER_RAMP_SECONDS = 0.02; //!< How long it takes depth, gain, and spread to reach a new value.
+    static constexpr double BYPASS_RAMP_SECONDS = 0.01;    //!< How long the crossfade into and out of bypass takes.
+
+    juce::int64 m_silentSamples = 0;      //!< How many samples in a row the input has been silent.
+    juce::int64 m_silenceHoldSamples = 0; //!< SILENCE_HOLD_SECONDS in samples. Set in prepareToPlay().
+
+    static constexpr double SILENCE_THRESHOLD = 1e-6;   //!< Input below this (-120 dB) counts as silence.
+    static constexpr double SILENCE_HOLD_SECONDS = 0.1; //!< How long the input must be silent before we go idle.
+
+    using ValueBuffer = std::vector<double, CacheLine::Allocator<double>>;
+
+    ValueBuffer m_tremoloValues;      //!< Holds one block's worth of tremolo effect values. Sized in prepareToPlay().
+    ValueBuffer m_rightTremoloValues; //!< Same as m_tremoloValues, for the right channel of a stereo spread.
+
+    PerformanceMonitor m_performanceMonitor; //!< Times every block.
+    ScopeFifo m_scopeFifo;                   //!< Points on their way to the editor's scope.
+
+    // What follows is written on other threads too, so it starts on a cache
+    // line of its own. The triple buffers pad their slots out themselves.
+
+    alignas(CacheLine::SIZE) std::atomic<bool> m_speedChanged{ true }; //!< Set whenever the speed parameter changes. Cleared by the audio thread.
+
+    std::atomic<SinePrecision> m_sinePrecision{ SinePrecision::Standard }; //!< How accurately the sine wave shape is calculated.
+    std::atomic<LfoInterpolation> m_lfoInterpolation{ LfoInterpolation::None }; //!< Whether the sine wave shape is calculated at control rate.
+
+    juce::SpinLock m_sineTableBuildLock;           //!< Makes sure only one thread builds a sine table at a time.
+    std::atomic<bool> m_sineTableDirty{ false };   //!< Set whenever the sine precision changes.
+
+    TripleBuffer<EnvelopeTable> m_sineTables; //!< One period of the sine shape, built off the audio thread.
+
     AudioParameters m_audioParams;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TremoloAudioProcessor)
@@ -0,0 +1,508 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "dsp/TremoloBank.h"
+#include "dsp/PhaseAccumulator.h"
+#include "dsp/SineKernel.h"
+#include "dsp/TremoloKernels.h"
+#include "dsp/WaveShapes.h"
+#include "common/AudioParams.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * Everything a tile kernel needs to process one block for one tile.
+     */
+    template <typename FloatType>
+    struct TileContext
+    {
+        FloatType* const* pChannels = nullptr;           //!< The channels of the tile's first voice, followed by the others.
+        int numChannels = 0;                             //!< The number of channels in every stream.
+        int numVoices = 0;                               //!< The number of real (not padding) voices in the tile.
+        int numSamples = 0;                              //!< The number of samples in every channel.
+        const TremoloBank::VoiceTile *pVoices = nullptr; //!< The state of the tile's voices.
+        double *pLeftValues = nullptr;                   //!< Scratch space for VOICE_TILE x CHUNK_SIZE values.
+        double *pRightValues = nullptr;                  //!< More scratch space, for the right channel of stereo streams.
+    };
+
+    /**
+     * Blends the three wave shapes by the voice's weights, which keep the
+     * one the voice uses. No branches, so it vectorizes across voices that
+     * use different shapes.
+     *
+     * @param sineValue The sine shape at the given phase. See startSine().
+     */
+    forcedinline double blendedShapeValue(const TremoloBank::VoiceTile &voices, int voice, double sineValue, double phase)
+    {
+        return sineValue * voices.sineWeights[voice]
+            + WaveShapes::square(phase) * voices.squareWeights[voice]
+            + WaveShapes::triangle(phase) * voices.triangleWeights[voice];
+    }
+
+    /**
+     * The sine shape isn't evaluated from scratch for every sample. Instead,
+     * the pair (-cos, sin) of the phase is rotated by the phase delta from
+     * one sample to the next, which is 4 multiplies. This starts the pair off
+     * at the given phase with the exact polynomial. We do that at the start
+     * of every chunk, so rounding errors only have CHUNK_SIZE samples to
+     * build up.
+     */
+    forcedinline void startSine(double phase, double &sineValue, double &sineQuadrature)
+    {
+        sineValue = SineKernel::value(phase, SineKernel::HIGH_COEFFS);
+        sineQuadrature = SineKernel::value(TremoloKernels::wrapPhase(phase + 0.25), SineKernel::HIGH_COEFFS);
+    }
+
+    /**
+     * Advances a pair from startSine() by the angle whose cosine and sine are given.
+     */
+    forcedinline void rotateSine(double &sineValue, double &sineQuadrature, double rotationCos, double rotationSin)
+    {
+        const double value = sineValue;
+        sineValue = value * rotationCos + sineQuadrature * rotationSin;
+        sineQuadrature = sineQuadrature * rotationCos - value * rotationSin;
+    }
+
+    /**
+     * Calculates one chunk of tremolo values for every voice in the tile. The
+     * inner loops run across voices, one per vector lane. Each voice's values
+     * are stored together (CHUNK_SIZE apart from the next voice's), so
+     * applying them to a stream is a plain vectorizable loop again.
+     */
+    template <bool withRight>
+    forcedinline void renderTileValues(const TremoloBank::VoiceTile &voices, int chunkStart, int chunkSize,
+        double *pLeftValues, double *pRightValues)
+    {
+        constexpr int tile = TremoloBank::VOICE_TILE;
+        constexpr int stride = TremoloBank::CHUNK_SIZE;
+
+        double leftSines[tile], leftQuadratures[tile];
+        double rightSines[tile], rightQuadratures[tile];
+        for (int voice = 0; voice < tile; ++voice)
+        {
+            const double n = chunkStart;
+            const double phase = TremoloKernels::wrapPhase(voices.startPhases[voice] + voices.phaseDeltas[voice] * n);
+            startSine(phase, leftSines[voice], leftQuadratures[voice]);
+
+            if (withRight)
+            {
+                const double spread = voices.spreads[voice] + voices.spreadSteps[voice] * std::min(n, voices.rampSamplesLeft[voice]);
+                startSine(TremoloKernels::wrapPhase(phase + spread), rightSines[voice], rightQuadratures[voice]);
+            }
+        }
+
+        for (int i = 0; i < chunkSize; ++i)
+        {
+            const double n = chunkStart + i;
+            double *pLeft = pLeftValues + i;
+            double *pRight = pRightValues + i;
+
+            for (int voice = 0; voice < tile; ++voice)
+            {
+                const double rampPosition = std::min(n, voices.rampSamplesLeft[voice]);
+                const double scale = voices.scales[voice] + voices.scaleSteps[voice] * rampPosition;
+                const double offset = voices.offsets[voice] + voices.offsetSteps[voice] * rampPosition;
+                const double phase = TremoloKernels::wrapPhase(voices.startPhases[voice] + voices.phaseDeltas[voice] * n);
+
+                pLeft[voice * stride] = blendedShapeValue(voices, voice, leftSines[voice], phase) * scale + offset;
+                rotateSine(leftSines[voice], leftQuadratures[voice], voices.rotationCos[voice], voices.rotationSin[voice]);
+            }
+
+            if (!withRight)
+                continue;
+
+            for (int voice = 0; voice < tile; ++voice)
+            {
+                const double rampPosition = std::min(n, voices.rampSamplesLeft[voice]);
+                const double scale = voices.scales[voice] + voices.scaleSteps[voice] * rampPosition;
+                const double offset = voices.offsets[voice] + voices.offsetSteps[voice] * rampPosition;
+                const double spread = voices.spreads[voice] + voices.spreadSteps[voice] * rampPosition;
+                const double phase = TremoloKernels::wrapPhase(voices.startPhases[voice] + voices.phaseDeltas[voice] * n + spread);
+
+                pRight[voice * stride] = blendedShapeValue(voices, voice, rightSines[voice], phase) * scale + offset;
+
+                // While the spread ramps, the right channel moves a little
+                // faster or slower than the left.
+                const bool isRamping = (n < voices.rampSamplesLeft[voice]);
+                rotateSine(rightSines[voice], rightQuadratures[voice],
+                    isRamping ? voices.spreadRotationCos[voice] : voices.rotationCos[voice],
+                    isRamping ? voices.spreadRotationSin[voice] : voices.rotationSin[voice]);
+            }
+        }
+    }
+
+    /**
+     * Multiplies one chunk of the tile's streams by the values from
+     * renderTileValues(). With withRight, the second channel of every stream
+     * gets the right channel values.
+     */
+    template <bool withRight, typename FloatType>
+    forcedinline void applyTileValues(const TileContext<FloatType> &context, int chunkStart, int chunkSize)
+    {
+        for (int voice = 0; voice < context.numVoices; ++voice)
+        {
+            for (int channel = 0; channel < context.numChannels; ++channel)
+            {
+                const double *pValues = ((withRight && channel == 1) ? context.pRightValues : context.pLeftValues)
+                    + voice * TremoloBank::CHUNK_SIZE;
+                FloatType *pSamples = context.pChannels[voice * context.numChannels + channel] + chunkStart;
+
+                for (int i = 0; i < chunkSize; ++i)
+                    pSamples[i] = static_cast<FloatType>(static_cast<double>(pSamples[i]) * pValues[i]);
+            }
+        }
+    }
+
+    /**
+     * Processes one block for one tile, a chunk at a time.
+     */
+    template <bool withRight, typename FloatType>
+    forcedinline void processTileBlock(const TileContext<FloatType> &context)
+    {
+        // Working on a copy lets the compiler see that the voice state and the
+        // scratch buffers don't overlap. Without that, it won't vectorize.
+        const TremoloBank::VoiceTile voices = *context.pVoices;
+
+        for (int chunkStart = 0; chunkStart < context.numSamples; chunkStart += TremoloBank::CHUNK_SIZE)
+        {
+            const int chunkSize = std::min(TremoloBank::CHUNK_SIZE, context.numSamples - chunkStart);
+            renderTileValues<withRight>(voices, chunkStart, chunkSize, context.pLeftValues, context.pRightValues);
+            applyTileValues<withRight>(context, chunkStart, chunkSize);
+        }
+    }
+
+    /**
+     * Declares the tile kernel compiled for a particular instruction set, the
+     * same way TremoloKernels does for the plugin's kernels.
+     */
+    #define TREMOLO_DECLARE_BANK_KERNELS(name, targetAttribute) \
+        struct name \
+        { \
+            template <bool withRight, typename FloatType> \
+            targetAttribute static void processTile(const TileContext<FloatType> &context) \
+            { \
+                processTileBlock<withRight>(context); \
+            } \
+        };
+
+    TREMOLO_DECLARE_BANK_KERNELS(GenericBankKernels, )
+#if TREMOLO_HAS_ISA_DISPATCH
+    TREMOLO_DECLARE_BANK_KERNELS(SSE42BankKernels, TREMOLO_TARGET_SSE42)
+    TREMOLO_DECLARE_BANK_KERNELS(AVX2BankKernels, TREMOLO_TARGET_AVX2)
+    TREMOLO_DECLARE_BANK_KERNELS(AVX512BankKernels, TREMOLO_TARGET_AVX512)
+#endif
+
+    #undef TREMOLO_DECLARE_BANK_KERNELS
+
+    //! Signature shared by all tile kernels.
+    template <typename FloatType>
+    using TileKernelFunction = void (*)(const TileContext<FloatType> &context);
+
+    /**
+     * Returns the tile kernel for the given instruction set. Stereo spread
+     * needs a second set of values, which withRight turns on.
+     */
+    template <typename FloatType>
+    TileKernelFunction<FloatType> getTileKernel(InstructionSet instructionSet, bool withRight)
+    {
+        switch (instructionSet)
+        {
+#if TREMOLO_HAS_ISA_DISPATCH
+            case InstructionSet::AVX512:
+                return withRight ? &AVX512BankKernels::processTile<true, FloatType> : &AVX512BankKernels::processTile<false, FloatType>;
+            case InstructionSet::AVX2:
+                return withRight ? &AVX2BankKernels::processTile<true, FloatType> : &AVX2BankKernels::processTile<false, FloatType>;
+            case InstructionSet::SSE42:
+                return withRight ? &SSE42BankKernels::processTile<true, FloatType> : &SSE42BankKernels::processTile<false, FloatType>;
+#endif
+            case InstructionSet::Generic:
+            default:
+                return withRight ? &GenericBankKernels::processTile<true, FloatType> : &GenericBankKernels::processTile<false, FloatType>;
+        }
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+TremoloBank::VoiceSettings TremoloBank::VoiceSettings::fromParameters(const AudioParameters &audioParams)
+{
+    VoiceSettings settings;
+    settings.speedInHz = *audioParams.m_pSpeedParamInHz;
+    settings.depth = *audioParams.m_pDepthParamInPercent;
+    settings.gain = *audioParams.m_pGainParamInPercent;
+    settings.oscillatorType = audioParams.m_pOscillatorType->getIndex();
+    settings.spreadInDegrees = *audioParams.m_pSpreadParamInDegrees;
+    settings.tempoSync = *audioParams.m_pTempoSync;
+    settings.syncDivision = audioParams.m_pSyncDivision->getIndex();
+    settings.bypass = *audioParams.m_pBypass;
+    return settings;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+TremoloBank::TremoloBank()
+    : m_instructionSet(InstructionSets::select())
+{
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloBank::prepare(double sampleRate, int numVoices, int numChannelsPerStream)
+{
+    m_sampleRate = sampleRate;
+    m_numVoices = std::max(numVoices, 0);
+    m_numChannelsPerStream = std::max(numChannelsPerStream, 0);
+    m_rampSamples = std::floor(sampleRate * PARAMETER_RAMP_SECONDS);
+
+    m_settings.assign(static_cast<size_t>(m_numVoices), VoiceSettings());
+    m_tiles.assign(static_cast<size_t>((m_numVoices + VOICE_TILE - 1) / VOICE_TILE), VoiceTile());
+
+    m_leftValues.assign(static_cast<size_t>(CHUNK_SIZE * VOICE_TILE), 0.0);
+    m_rightValues.assign(m_leftValues.size(), 0.0);
+
+    for (int voice = 0; voice < m_numVoices; ++voice)
+    {
+        setVoiceSettings(voice, m_settings[static_cast<size_t>(voice)]);
+        resetVoice(voice);
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloBank::setVoiceSettings(int voiceIndex, const VoiceSettings &settings)
+{
+    if (voiceIndex < 0 || voiceIndex >= m_numVoices)
+    {
+        jassertfalse; // No such voice. Has prepare() been called?
+        return;
+    }
+
+    VoiceSettings &voiceSettings = m_settings[static_cast<size_t>(voiceIndex)];
+    voiceSettings = settings;
+    voiceSettings.speedInHz = juce::jlimit(1.0, 40.0, settings.speedInHz);
+    voiceSettings.depth = juce::jlimit(0.0, 1.0, settings.depth);
+    voiceSettings.gain = juce::jlimit(0.0, 1.0, settings.gain);
+    voiceSettings.oscillatorType = juce::jlimit(0, 2, settings.oscillatorType);
+    voiceSettings.spreadInDegrees = juce::jlimit(0.0, 180.0, settings.spreadInDegrees);
+    voiceSettings.syncDivision = juce::jlimit(0, SyncDivisions::NUM_DIVISIONS - 1, settings.syncDivision);
+
+    size_t lane = 0;
+    VoiceTile &tile = getTile(voiceIndex, lane);
+
+    tile.sineWeights[lane] = (voiceSettings.oscillatorType == 0) ? 1.0 : 0.0;
+    tile.squareWeights[lane] = (voiceSettings.oscillatorType == 1) ? 1.0 : 0.0;
+    tile.triangleWeights[lane] = (voiceSettings.oscillatorType == 2) ? 1.0 : 0.0;
+    updatePhaseIncrement(voiceIndex);
+
+    // Bypass fades to a flat gain of 1.0.
+    if (voiceSettings.bypass)
+    {
+        tile.targetScales[lane] = 0.0;
+        tile.targetOffsets[lane] = 1.0;
+    }
+    else
+    {
+        TremoloKernels::calculateScaleAndOffset(voiceSettings.depth, voiceSettings.gain,
+            tile.targetScales[lane], tile.targetOffsets[lane]);
+    }
+    tile.targetSpreads[lane] = voiceSettings.spreadInDegrees / 360.0;
+
+    // Ramp linearly from wherever we are now. Ramping the scale and offset
+    // (rather than depth and gain separately) keeps the ramp one
+    // multiply-add per sample.
+    if (m_rampSamples < 1.0)
+    {
+        tile.scales[lane] = tile.targetScales[lane];
+        tile.offsets[lane] = tile.targetOffsets[lane];
+        tile.spreads[lane] = tile.targetSpreads[lane];
+        return;
+    }
+
+    tile.scaleSteps[lane] = (tile.targetScales[lane] - tile.scales[lane]) / m_rampSamples;
+    tile.offsetSteps[lane] = (tile.targetOffsets[lane] - tile.offsets[lane]) / m_rampSamples;
+    tile.spreadSteps[lane] = (tile.targetSpreads[lane] - tile.spreads[lane]) / m_rampSamples;
+    tile.rampSamplesLeft[lane] = m_rampSamples;
+    updateRotations(tile, lane);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+const TremoloBank::VoiceSettings &TremoloBank::getVoiceSettings(int voiceIndex) const
+{
+    jassert(voiceIndex >= 0 && voiceIndex < m_numVoices);
+    return m_settings[static_cast<size_t>(voiceIndex)];
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloBank::setTempo(double bpm)
+{
+    m_bpm = bpm;
+    for (int voice = 0; voice < m_numVoices; ++voice)
+    {
+        if (m_settings[static_cast<size_t>(voice)].tempoSync)
+            updatePhaseIncrement(voice);
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloBank::resetVoice(int voiceIndex)
+{
+    if (voiceIndex < 0 || voiceIndex >= m_numVoices)
+    {
+        jassertfalse; // No such voice. Has prepare() been called?
+        return;
+    }
+
+    size_t lane = 0;
+    VoiceTile &tile = getTile(voiceIndex, lane);
+    tile.phases[lane] = 0;
+    tile.scales[lane] = tile.targetScales[lane];
+    tile.offsets[lane] = tile.targetOffsets[lane];
+    tile.spreads[lane] = tile.targetSpreads[lane];
+    tile.scaleSteps[lane] = 0.0;
+    tile.offsetSteps[lane] = 0.0;
+    tile.spreadSteps[lane] = 0.0;
+    tile.rampSamplesLeft[lane] = 0.0;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloBank::process(float* const* pChannels, int numSamples)
+{
+    processSamples(pChannels, numSamples);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloBank::process(double* const* pChannels, int numSamples)
+{
+    processSamples(pChannels, numSamples);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+template <typename FloatType>
+void TremoloBank::processSamples(FloatType* const* pChannels, int numSamples)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    if (m_numVoices == 0 || m_numChannelsPerStream == 0 || numSamples <= 0)
+        return;
+
+    const bool isStereo = (m_numChannelsPerStream == 2);
+
+    TileContext<FloatType> context;
+    context.numChannels = m_numChannelsPerStream;
+    context.numSamples = numSamples;
+    context.pLeftValues = m_leftValues.data();
+    context.pRightValues = m_rightValues.data();
+
+    for (size_t tileIndex = 0; tileIndex < m_tiles.size(); ++tileIndex)
+    {
+        VoiceTile &tile = m_tiles[tileIndex];
+        const int firstVoice = static_cast<int>(tileIndex) * VOICE_TILE;
+
+        // Every sample's phase is calculated from the block's start phase,
+        // just like the plugin's kernels do. The right channel only needs
+        // values of its own if some voice has (or is ramping to or from) a
+        // spread.
+        bool hasSpread = false;
+        for (int voice = 0; voice < VOICE_TILE; ++voice)
+        {
+            tile.startPhases[voice] = PhaseAccumulator::toDouble(tile.phases[voice]);
+            hasSpread = hasSpread || (tile.spreads[voice] != 0.0) || (tile.spreadSteps[voice] != 0.0);
+        }
+
+        context.pChannels = pChannels + firstVoice * m_numChannelsPerStream;
+        context.numVoices = std::min(VOICE_TILE, m_numVoices - firstVoice);
+        context.pVoices = &tile;
+        getTileKernel<FloatType>(m_instructionSet, isStereo && hasSpread)(context);
+    }
+
+    advance(numSamples);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloBank::advance(int numSamples)
+{
+    const uint64_t numSamplesFixed = static_cast<uint64_t>(numSamples);
+    const double n = numSamples;
+
+    for (VoiceTile &tile : m_tiles)
+    {
+        for (int voice = 0; voice < VOICE_TILE; ++voice)
+            tile.phases[voice] += tile.phaseIncrements[voice] * numSamplesFixed;
+
+        for (int voice = 0; voice < VOICE_TILE; ++voice)
+        {
+            // Land exactly on the target once the ramp is over.
+            const double rampPosition = std::min(n, tile.rampSamplesLeft[voice]);
+            const bool isDone = (tile.rampSamplesLeft[voice] <= n);
+            tile.scales[voice] = isDone ? tile.targetScales[voice] : tile.scales[voice] + tile.scaleSteps[voice] * rampPosition;
+            tile.offsets[voice] = isDone ? tile.targetOffsets[voice] : tile.offsets[voice] + tile.offsetSteps[voice] * rampPosition;
+            tile.spreads[voice] = isDone ? tile.targetSpreads[voice] : tile.spreads[voice] + tile.spreadSteps[voice] * rampPosition;
+            tile.scaleSteps[voice] = isDone ? 0.0 : tile.scaleSteps[voice];
+            tile.offsetSteps[voice] = isDone ? 0.0 : tile.offsetSteps[voice];
+            tile.spreadSteps[voice] = isDone ? 0.0 : tile.spreadSteps[voice];
+            tile.rampSamplesLeft[voice] -= rampPosition;
+        }
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+TremoloBank::VoiceTile &TremoloBank::getTile(int voiceIndex, size_t &lane)
+{
+    lane = static_cast<size_t>(voiceIndex % VOICE_TILE);
+    return m_tiles[static_cast<size_t>(voiceIndex / VOICE_TILE)];
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloBank::updatePhaseIncrement(int voiceIndex)
+{
+    const VoiceSettings &settings = m_settings[static_cast<size_t>(voiceIndex)];
+    const double frequency = settings.tempoSync ? TempoSync::calculateFrequency(m_bpm, settings.syncDivision)
+                                                : settings.speedInHz;
+
+    size_t lane = 0;
+    VoiceTile &tile = getTile(voiceIndex, lane);
+    tile.phaseIncrements[lane] = PhaseAccumulator::calculateIncrement(frequency, m_sampleRate);
+    tile.phaseDeltas[lane] = PhaseAccumulator::toDouble(tile.phaseIncrements[lane]);
+    updateRotations(tile, lane);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloBank::updateRotations(VoiceTile &tile, size_t lane)
+{
+    const double twoPi = juce::MathConstants<double>::twoPi;
+    const double angle = twoPi * tile.phaseDeltas[lane];
+    const double spreadAngle = twoPi * (tile.phaseDeltas[lane] + tile.spreadSteps[lane]);
+
+    tile.rotationCos[lane] = std::cos(angle);
+    tile.rotationSin[lane] = std::sin(angle);
+    tile.spreadRotationCos[lane] = std::cos(spreadAngle);
+    tile.spreadRotationSin[lane] = std::sin(spreadAngle);
+}
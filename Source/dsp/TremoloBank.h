@@ -0,0 +1,230 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "InstructionSet.h"
+#include "TempoSync.h"
+#include <juce_core/juce_core.h>
+#include <cstdint>
+#include <vector>
+
+struct AudioParameters;
+
+/**
+ * Runs the tremolo on many independent streams (voices) at once, each with
+ * its own settings. Meant for servers rendering hundreds of streams, where
+ * one TremoloAudioProcessor per stream spends most of its time on
+ * per-instance overhead rather than on audio.
+ *
+ * The state of every voice lives in structure-of-arrays form, in tiles of
+ * VOICE_TILE voices: one array for the tile's phases, one for its phase
+ * deltas, one for its depths, and so on. The tremolo values are calculated
+ * a tile at a time, with the inner loop running across voices rather than
+ * across samples, so every vector lane works on a different voice. Each
+ * voice may use a different wave shape, so the shapes are evaluated without
+ * branches and blended by per-voice weights that are 1.0 for the selected
+ * shape and 0.0 for the others.
+ *
+ * Voice settings mean exactly what the plugin's parameters mean (see
+ * AudioParameters), and the phase is kept in the same 64-bit fixed point
+ * as PhaseAccumulator. A voice therefore follows the same phase as a
+ * TremoloAudioProcessor with the same settings, give or take the accuracy
+ * of the sine shape.
+ *
+ * Depth, gain, spread, and bypass changes are ramped over
+ * PARAMETER_RAMP_SECONDS, like the plugin does. The bank is NOT thread-safe.
+ * Settings must be changed on the thread that calls process(), in between
+ * calls.
+ *
+ * The plugin doesn't use the bank, so it's only built into SKTremoloBench.
+ * SKTremoloBench --scaling measures how many streams it runs per core, and
+ * SKTremoloBench --check compares it against TremoloAudioProcessor.
+ */
+class TremoloBank
+{
+public:
+
+    /**
+     * The settings of one voice. The defaults and ranges match the plugin's
+     * parameters. Out of range values are clamped.
+     */
+    struct VoiceSettings
+    {
+        double speedInHz = 2.0;                               //!< How fast the tremolo oscillates, 1 to 40 Hz.
+        double depth = 1.0;                                   //!< 1.0 goes from full gain to zero. 0.0 is no oscillation at all.
+        double gain = 1.0;                                    //!< Overall gain, 0.0 to 1.0.
+        int oscillatorType = 0;                               //!< 0 = sine, 1 = square, 2 = triangle.
+        double spreadInDegrees = 0.0;                         //!< How far the right channel runs ahead of the left, 0 to 180. Stereo streams only.
+        bool tempoSync = false;                               //!< When true, one oscillation lasts syncDivision at the bank's tempo.
+        int syncDivision = SyncDivisions::DEFAULT_INDEX;      //!< An index into SyncDivisions::getNames().
+        bool bypass = false;                                  //!< Passes the stream through untouched, after a short crossfade.
+
+        /**
+         * Returns the settings held by the given plugin parameters.
+         */
+        static VoiceSettings fromParameters(const AudioParameters &audioParams);
+    };
+
+    //! The number of voices processed side by side, one per vector lane.
+    static constexpr int VOICE_TILE = 16;
+
+    /**
+     * The state of VOICE_TILE voices, side by side. A bank with a number of
+     * voices that isn't a multiple of VOICE_TILE has padding voices at the
+     * end of its last tile. Those are all zeros, so they never produce
+     * anything but silence.
+     */
+    struct alignas(64) VoiceTile
+    {
+        uint64_t phases[VOICE_TILE];          //!< Phase of every voice, in PhaseAccumulator's fixed point.
+        uint64_t phaseIncrements[VOICE_TILE]; //!< Fixed-point change in phase with every sample.
+        double startPhases[VOICE_TILE];       //!< phases as doubles, as of the start of the block.
+        double phaseDeltas[VOICE_TILE];       //!< phaseIncrements as doubles.
+        double rotationCos[VOICE_TILE];       //!< cos(2 * pi * phase delta). Steps the sine shape from one sample to the next.
+        double rotationSin[VOICE_TILE];       //!< sin(2 * pi * phase delta).
+        double spreadRotationCos[VOICE_TILE]; //!< Same as rotationCos, for the right channel while the spread ramps.
+        double spreadRotationSin[VOICE_TILE]; //!< Same as rotationSin, for the right channel while the spread ramps.
+        double scales[VOICE_TILE];            //!< Current scale. See TremoloKernels::calculateScaleAndOffset().
+        double scaleSteps[VOICE_TILE];        //!< How much the scale changes with every sample while ramping.
+        double targetScales[VOICE_TILE];      //!< The scale we're ramping to.
+        double offsets[VOICE_TILE];           //!< Current offset. See TremoloKernels::calculateScaleAndOffset().
+        double offsetSteps[VOICE_TILE];       //!< How much the offset changes with every sample while ramping.
+        double targetOffsets[VOICE_TILE];     //!< The offset we're ramping to.
+        double spreads[VOICE_TILE];           //!< Current right channel phase offset (0.0 to 0.5).
+        double spreadSteps[VOICE_TILE];       //!< How much the spread changes with every sample while ramping.
+        double targetSpreads[VOICE_TILE];     //!< The spread we're ramping to.
+        double rampSamplesLeft[VOICE_TILE];   //!< How many samples are left in the ramp. 0.0 when not ramping.
+        double sineWeights[VOICE_TILE];       //!< 1.0 if the voice uses the sine shape, 0.0 if not.
+        double squareWeights[VOICE_TILE];     //!< 1.0 if the voice uses the square shape, 0.0 if not.
+        double triangleWeights[VOICE_TILE];   //!< 1.0 if the voice uses the triangle shape, 0.0 if not.
+    };
+
+    //! The number of samples calculated per tile before they're applied to the streams.
+    static constexpr int CHUNK_SIZE = 64;
+
+    //! How long it takes depth, gain, spread, and bypass to reach a new value. Same as the plugin.
+    static constexpr double PARAMETER_RAMP_SECONDS = 0.02;
+
+    /**
+     * Constructor. The bank has no voices until prepare() is called.
+     */
+    TremoloBank();
+
+    /**
+     * Sets up the bank for the given number of voices. Every voice starts out
+     * with default settings at phase 0.0. Allocates, so don't call it from a
+     * thread that mustn't block.
+     *
+     * @param sampleRate The sample rate shared by all streams.
+     * @param numVoices The number of voices (streams).
+     * @param numChannelsPerStream The number of channels in every stream.
+     *        Stereo streams (2 channels) get the stereo spread.
+     */
+    void prepare(double sampleRate, int numVoices, int numChannelsPerStream);
+
+    /**
+     * Returns the number of voices set up by prepare().
+     */
+    int getNumVoices() const { return m_numVoices; }
+
+    /**
+     * Returns the number of channels in every stream.
+     */
+    int getNumChannelsPerStream() const { return m_numChannelsPerStream; }
+
+    /**
+     * Changes the settings of a voice. The oscillator shape and speed change
+     * right away. Everything else ramps to its new value.
+     *
+     * @param voiceIndex The voice, 0 to getNumVoices() - 1.
+     * @param settings The new settings.
+     */
+    void setVoiceSettings(int voiceIndex, const VoiceSettings &settings);
+
+    /**
+     * Returns the settings of a voice, as last set.
+     */
+    const VoiceSettings &getVoiceSettings(int voiceIndex) const;
+
+    /**
+     * Sets the tempo that voices with tempo sync turned on follow. Defaults
+     * to TempoSync::DEFAULT_BPM.
+     *
+     * @param bpm The tempo in quarter notes per minute.
+     */
+    void setTempo(double bpm);
+
+    /**
+     * Puts a voice back at phase 0.0 and skips any ramps in progress. Call
+     * this when a voice starts on a new stream.
+     */
+    void resetVoice(int voiceIndex);
+
+    /**
+     * Applies the tremolo to every stream in place.
+     *
+     * @param pChannels Pointers to the channels of every stream. Channel c of
+     *        voice v is at pChannels[v * getNumChannelsPerStream() + c].
+     * @param numSamples The number of samples in every channel.
+     */
+    void process(float* const* pChannels, int numSamples);
+
+    /**
+     * Double precision version of process().
+     */
+    void process(double* const* pChannels, int numSamples);
+
+    /**
+     * Returns the instruction set the bank runs with. See InstructionSets::select().
+     */
+    InstructionSet getInstructionSet() const { return m_instructionSet; }
+
+private:
+
+    /**
+     * Does the actual work for both process() overloads.
+     */
+    template <typename FloatType>
+    void processSamples(FloatType* const* pChannels, int numSamples);
+
+    /**
+     * Moves every voice forward by the given number of samples, once the
+     * block has been processed.
+     */
+    void advance(int numSamples);
+
+    /**
+     * Returns the tile holding the given voice and the voice's lane in it.
+     */
+    VoiceTile &getTile(int voiceIndex, size_t &lane);
+
+    /**
+     * Recalculates a voice's phase delta from its settings and the tempo.
+     */
+    void updatePhaseIncrement(int voiceIndex);
+
+    /**
+     * Recalculates the rotations that step a voice's sine shape along, after
+     * its phase delta or spread ramp changed.
+     */
+    static void updateRotations(VoiceTile &tile, size_t lane);
+
+    const InstructionSet m_instructionSet; //!< The instruction set the tile kernels run with.
+
+    double m_sampleRate = 0.0;             //!< The sample rate shared by all streams.
+    double m_bpm = TempoSync::DEFAULT_BPM; //!< The tempo synced voices follow.
+    int m_numVoices = 0;                   //!< The number of voices.
+    int m_numChannelsPerStream = 0;        //!< The number of channels in every stream.
+    double m_rampSamples = 0.0;            //!< PARAMETER_RAMP_SECONDS in samples.
+
+    std::vector<VoiceSettings> m_settings; //!< The settings of every voice, as last set.
+
+    std::vector<VoiceTile> m_tiles; //!< The state of every voice, VOICE_TILE voices per tile.
+
+    std::vector<double> m_leftValues;  //!< Tremolo values for one tile, VOICE_TILE x CHUNK_SIZE.
+    std::vector<double> m_rightValues; //!< Same as m_leftValues, for the right channel of stereo streams.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TremoloBank)
+};
@@ -0,0 +1,451 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "ControlRateLfo.h"
+#include "EnvelopeTable.h"
+#include "InstructionSet.h"
+#include "WaveShapes.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+
+/**
+ * Tremolo kernels that are specialized at compile time for each wave shape
+ * and channel layout. TremoloAudioProcessor picks one kernel per block from
+ * getKernel(), so the per-sample loops don't contain a single branch on
+ * wave form, depth, or channel count and are easy for the compiler to
+ * vectorize.
+ *
+ * Every kernel is compiled once per InstructionSet, so machines with wider
+ * vector units get loops vectorized for them while older machines still
+ * run the same binary.
+ *
+ * Depth and gain don't need a kernel of their own. Both are constant for
+ * the block, so they fold into a single multiply-add per sample:
+ *
+ *     gain * (depth * (value + 1) / 2 + (1 - depth)) == value * scale + offset
+ */
+namespace TremoloKernels
+{
+    /**
+     * Everything a kernel needs to process one block.
+     */
+    template <typename FloatType>
+    struct BlockContext
+    {
+        FloatType* const* pChannels = nullptr;     //!< The channels to process in place.
+        int numChannels = 0;                       //!< The number of channels in pChannels.
+        int numSamples = 0;                        //!< The number of samples in each channel.
+        double startPhase = 0.0;                   //!< The phase of the first sample.
+        double phaseDelta = 0.0;                   //!< How much the phase advances with every sample.
+        double scale = 1.0;                        //!< See the namespace description.
+        double offset = 0.0;                       //!< See the namespace description.
+        const EnvelopeTable *pSineTable = nullptr; //!< Used by the sine shape.
+        double *pScratch = nullptr;                //!< Scratch space for layouts that need it.
+        double *pRightScratch = nullptr;           //!< More scratch space, for the right channel of a spread stereo pair.
+        int scratchSize = 0;                       //!< The number of values pScratch and pRightScratch can hold.
+        int controlInterval = 1;                   //!< Used by the control rate kernels. See ControlRateLfo.
+        double rightPhaseOffset = 0.0;             //!< How far the right channel's phase is ahead of the left's (0.0 to 0.5). Stereo only.
+    };
+
+    /**
+     * Converts a scale/offset pair from depth and gain. See the namespace description.
+     */
+    inline void calculateScaleAndOffset(double depth, double gain, double &scale, double &offset)
+    {
+        scale = gain * depth * 0.5;
+        offset = gain * (1.0 - depth * 0.5);
+    }
+
+    /**
+     * Wraps a phase that's known not to be negative back into [0, 1).
+     */
+    inline double wrapPhase(double phase)
+    {
+        return phase - static_cast<int>(phase);
+    }
+
+    //! The sine shape. Reading back the cached table is cheaper than evaluating the curve.
+    struct SineShape
+    {
+        static double value(const EnvelopeTable &table, double phase) { return table.valueAt(phase); }
+    };
+
+    //! The square shape. Exact, and cheaper than a table read.
+    struct SquareShape
+    {
+        static double value(const EnvelopeTable &, double phase) { return WaveShapes::square(phase); }
+    };
+
+    //! The triangle shape. Exact, and cheaper than a table read.
+    struct TriangleShape
+    {
+        static double value(const EnvelopeTable &, double phase) { return WaveShapes::triangle(phase); }
+    };
+
+    //! One channel.
+    struct MonoLayout {};
+
+    //! Two channels.
+    struct StereoLayout {};
+
+    //! Two channels, the right one running ahead of the left by BlockContext::rightPhaseOffset.
+    struct StereoSpreadLayout {};
+
+    //! Any number of channels.
+    struct MultiChannelLayout {};
+
+    /**
+     * Multiplies every channel by the same modulation values, starting at
+     * startSample. This is the only part of the work that grows with the
+     * number of channels.
+     */
+    template <typename FloatType>
+    forcedinline void applyModulation(const double *pModulation, FloatType* const* pChannels, int numChannels,
+        int startSample, int numSamples)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            FloatType *pChannelValues = pChannels[channel] + startSample;
+            for (int i = 0; i < numSamples; ++i)
+                pChannelValues[i] = static_cast<FloatType>(static_cast<double>(pChannelValues[i]) * pModulation[i]);
+        }
+    }
+
+    /**
+     * Double precision version of applyModulation(). No conversions needed,
+     * so JUCE's vector operations can do it.
+     */
+    forcedinline void applyModulation(const double *pModulation, double* const* pChannels, int numChannels,
+        int startSample, int numSamples)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::multiply(pChannels[channel] + startSample, pModulation, numSamples);
+    }
+
+    /**
+     * Applies the tremolo to a single channel.
+     */
+    template <typename Shape, typename FloatType>
+    forcedinline void process(const BlockContext<FloatType> &context, MonoLayout)
+    {
+        const EnvelopeTable &table = *context.pSineTable;
+        FloatType *pLeft = context.pChannels[0];
+
+        for (int i = 0; i < context.numSamples; ++i)
+        {
+            const double phase = wrapPhase(context.startPhase + context.phaseDelta * i);
+            const double tremoloValue = Shape::value(table, phase) * context.scale + context.offset;
+            pLeft[i] = static_cast<FloatType>(static_cast<double>(pLeft[i]) * tremoloValue);
+        }
+    }
+
+    /**
+     * Applies the tremolo to a pair of channels.
+     */
+    template <typename Shape, typename FloatType>
+    forcedinline void process(const BlockContext<FloatType> &context, StereoLayout)
+    {
+        const EnvelopeTable &table = *context.pSineTable;
+        FloatType *pLeft = context.pChannels[0];
+        FloatType *pRight = context.pChannels[1];
+
+        for (int i = 0; i < context.numSamples; ++i)
+        {
+            const double phase = wrapPhase(context.startPhase + context.phaseDelta * i);
+            const double tremoloValue = Shape::value(table, phase) * context.scale + context.offset;
+            pLeft[i] = static_cast<FloatType>(static_cast<double>(pLeft[i]) * tremoloValue);
+            pRight[i] = static_cast<FloatType>(static_cast<double>(pRight[i]) * tremoloValue);
+        }
+    }
+
+    /**
+     * Applies the tremolo to a pair of channels, with the right channel's
+     * phase offset from the left's. Both phases come from the same start
+     * phase and delta, so they can never drift apart.
+     */
+    template <typename Shape, typename FloatType>
+    forcedinline void process(const BlockContext<FloatType> &context, StereoSpreadLayout)
+    {
+        const EnvelopeTable &table = *context.pSineTable;
+        FloatType *pLeft = context.pChannels[0];
+        FloatType *pRight = context.pChannels[1];
+
+        for (int i = 0; i < context.numSamples; ++i)
+        {
+            const double leftPhase = wrapPhase(context.startPhase + context.phaseDelta * i);
+            const double rightPhase = wrapPhase(leftPhase + context.rightPhaseOffset);
+            const double leftTremoloValue = Shape::value(table, leftPhase) * context.scale + context.offset;
+            const double rightTremoloValue = Shape::value(table, rightPhase) * context.scale + context.offset;
+            pLeft[i] = static_cast<FloatType>(static_cast<double>(pLeft[i]) * leftTremoloValue);
+            pRight[i] = static_cast<FloatType>(static_cast<double>(pRight[i]) * rightTremoloValue);
+        }
+    }
+
+    /**
+     * Applies the tremolo to any number of channels, in any layout (surround,
+     * ambisonics, ...). The tremolo values are calculated once per chunk into
+     * the scratch buffer and then applied to every channel.
+     */
+    template <typename Shape, typename FloatType>
+    forcedinline void process(const BlockContext<FloatType> &context, MultiChannelLayout)
+    {
+        const EnvelopeTable &table = *context.pSineTable;
+        double *pTremoloValues = context.pScratch;
+
+        for (int chunkStart = 0; chunkStart < context.numSamples; chunkStart += context.scratchSize)
+        {
+            const int chunkSize = std::min(context.scratchSize, context.numSamples - chunkStart);
+            const double chunkStartPhase = context.startPhase + context.phaseDelta * chunkStart;
+
+            for (int i = 0; i < chunkSize; ++i)
+            {
+                const double phase = wrapPhase(chunkStartPhase + context.phaseDelta * i);
+                pTremoloValues[i] = Shape::value(table, phase) * context.scale + context.offset;
+            }
+
+            applyModulation(pTremoloValues, context.pChannels, context.numChannels, chunkStart, chunkSize);
+        }
+    }
+
+    /**
+     * Interpolates one chunk of tremolo values at control rate.
+     */
+    template <typename Interpolation, typename FloatType>
+    forcedinline void renderControlRateChunk(const BlockContext<FloatType> &context, double startPhase, double *pDest, int numValues)
+    {
+        ControlRateLfo::render<Interpolation>(*context.pSineTable, startPhase, context.phaseDelta,
+            context.controlInterval, pDest, numValues);
+        for (int i = 0; i < numValues; ++i)
+            pDest[i] = pDest[i] * context.scale + context.offset;
+    }
+
+    /**
+     * Applies the sine shape at control rate to any number of channels. The
+     * tremolo values are interpolated once per chunk into the scratch buffer
+     * and then applied to every channel. A spread stereo pair gets a second
+     * set of values for the right channel.
+     */
+    template <typename Interpolation, typename FloatType>
+    forcedinline void processControlRate(const BlockContext<FloatType> &context)
+    {
+        const bool isSpread = (context.numChannels == 2) && (context.rightPhaseOffset != 0.0);
+
+        for (int chunkStart = 0; chunkStart < context.numSamples; chunkStart += context.scratchSize)
+        {
+            const int chunkSize = std::min(context.scratchSize, context.numSamples - chunkStart);
+            const double chunkStartPhase = wrapPhase(context.startPhase + context.phaseDelta * chunkStart);
+
+            renderControlRateChunk<Interpolation>(context, chunkStartPhase, context.pScratch, chunkSize);
+            if (!isSpread)
+            {
+                applyModulation(context.pScratch, context.pChannels, context.numChannels, chunkStart, chunkSize);
+                continue;
+            }
+
+            renderControlRateChunk<Interpolation>(context, chunkStartPhase + context.rightPhaseOffset,
+                context.pRightScratch, chunkSize);
+            applyModulation(context.pScratch, context.pChannels, 1, chunkStart, chunkSize);
+            applyModulation(context.pRightScratch, context.pChannels + 1, 1, chunkStart, chunkSize);
+        }
+    }
+
+    /**
+     * Fills the provided buffer with raw shape values (-1.0 to 1.0) without
+     * applying depth or gain. Used while depth or gain are being ramped.
+     */
+    template <typename Shape>
+    forcedinline void renderShapeValues(const EnvelopeTable &sineTable, double startPhase, double phaseDelta, double *pDest, int numValues)
+    {
+        for (int i = 0; i < numValues; ++i)
+            pDest[i] = Shape::value(sineTable, wrapPhase(startPhase + phaseDelta * i));
+    }
+
+    /**
+     * Declares a set of kernel entry points compiled for a particular
+     * instruction set. The loops above are force-inlined into them, so every
+     * instruction set gets its own copy of the loops, vectorized accordingly.
+     */
+    #define TREMOLO_DECLARE_KERNELS(name, targetAttribute) \
+        struct name \
+        { \
+            template <typename Shape, typename Layout, typename FloatType> \
+            targetAttribute static void processBlock(const BlockContext<FloatType> &context) \
+            { \
+                process<Shape>(context, Layout()); \
+            } \
+            \
+            template <typename Shape> \
+            targetAttribute static void renderShape(const EnvelopeTable &sineTable, double startPhase, double phaseDelta, double *pDest, int numValues) \
+            { \
+                renderShapeValues<Shape>(sineTable, startPhase, phaseDelta, pDest, numValues); \
+            } \
+            \
+            template <typename Interpolation, typename FloatType> \
+            targetAttribute static void processBlockControlRate(const BlockContext<FloatType> &context) \
+            { \
+                processControlRate<Interpolation>(context); \
+            } \
+            \
+            template <typename Interpolation> \
+            targetAttribute static void renderControlRate(const EnvelopeTable &sineTable, double startPhase, double phaseDelta, int interval, double *pDest, int numValues) \
+            { \
+                ControlRateLfo::render<Interpolation>(sineTable, startPhase, phaseDelta, interval, pDest, numValues); \
+            } \
+        };
+
+    TREMOLO_DECLARE_KERNELS(GenericKernels, )
+#if TREMOLO_HAS_ISA_DISPATCH
+    TREMOLO_DECLARE_KERNELS(SSE42Kernels, TREMOLO_TARGET_SSE42)
+    TREMOLO_DECLARE_KERNELS(AVX2Kernels, TREMOLO_TARGET_AVX2)
+    TREMOLO_DECLARE_KERNELS(AVX512Kernels, TREMOLO_TARGET_AVX512)
+#endif
+
+    #undef TREMOLO_DECLARE_KERNELS
+
+    //! Signature shared by all shape renderers.
+    using ShapeRenderFunction = void (*)(const EnvelopeTable &sineTable, double startPhase, double phaseDelta, double *pDest, int numValues);
+
+    //! Signature shared by the control rate renderers.
+    using ControlRateRenderFunction = void (*)(const EnvelopeTable &sineTable, double startPhase, double phaseDelta, int interval, double *pDest, int numValues);
+
+    //! Signature shared by all kernels.
+    template <typename FloatType>
+    using KernelFunction = void (*)(const BlockContext<FloatType> &context);
+
+    /**
+     * All kernels and shape renderers compiled for one instruction set.
+     * Kernels are indexed by [shape][layout], shape renderers by [shape].
+     * The control rate versions of both are indexed by [interpolation - 1].
+     */
+    template <typename FloatType>
+    struct KernelTable
+    {
+        std::array<std::array<KernelFunction<FloatType>, 4>, 3> kernels;
+        std::array<ShapeRenderFunction, 3> shapeRenderers;
+        std::array<KernelFunction<FloatType>, 2> controlRateKernels;
+        std::array<ControlRateRenderFunction, 2> controlRateRenderers;
+    };
+
+    /**
+     * Returns the kernel table for the given set of kernel entry points.
+     */
+    template <typename Kernels, typename FloatType>
+    const KernelTable<FloatType> &getKernelTable()
+    {
+        static constexpr KernelTable<FloatType> table =
+        {
+            { {
+                { &Kernels::template processBlock<SineShape, MonoLayout, FloatType>,
+                  &Kernels::template processBlock<SineShape, StereoLayout, FloatType>,
+                  &Kernels::template processBlock<SineShape, StereoSpreadLayout, FloatType>,
+                  &Kernels::template processBlock<SineShape, MultiChannelLayout, FloatType> },
+                { &Kernels::template processBlock<SquareShape, MonoLayout, FloatType>,
+                  &Kernels::template processBlock<SquareShape, StereoLayout, FloatType>,
+                  &Kernels::template processBlock<SquareShape, StereoSpreadLayout, FloatType>,
+                  &Kernels::template processBlock<SquareShape, MultiChannelLayout, FloatType> },
+                { &Kernels::template processBlock<TriangleShape, MonoLayout, FloatType>,
+                  &Kernels::template processBlock<TriangleShape, StereoLayout, FloatType>,
+                  &Kernels::template processBlock<TriangleShape, StereoSpreadLayout, FloatType>,
+                  &Kernels::template processBlock<TriangleShape, MultiChannelLayout, FloatType> }
+            } },
+            {
+                &Kernels::template renderShape<SineShape>,
+                &Kernels::template renderShape<SquareShape>,
+                &Kernels::template renderShape<TriangleShape>
+            },
+            {
+                &Kernels::template processBlockControlRate<ControlRateLfo::LinearInterpolation, FloatType>,
+                &Kernels::template processBlockControlRate<ControlRateLfo::CubicInterpolation, FloatType>
+            },
+            {
+                &Kernels::template renderControlRate<ControlRateLfo::LinearInterpolation>,
+                &Kernels::template renderControlRate<ControlRateLfo::CubicInterpolation>
+            }
+        };
+
+        return table;
+    }
+
+    /**
+     * Returns the kernel table compiled for the given instruction set.
+     */
+    template <typename FloatType>
+    const KernelTable<FloatType> &getKernelTable(InstructionSet instructionSet)
+    {
+        switch (instructionSet)
+        {
+#if TREMOLO_HAS_ISA_DISPATCH
+            case InstructionSet::AVX512: return getKernelTable<AVX512Kernels, FloatType>();
+            case InstructionSet::AVX2:   return getKernelTable<AVX2Kernels, FloatType>();
+            case InstructionSet::SSE42:  return getKernelTable<SSE42Kernels, FloatType>();
+#endif
+            case InstructionSet::Generic:
+            default:                     return getKernelTable<GenericKernels, FloatType>();
+        }
+    }
+
+    /**
+     * Returns the index of the layout that fits the given block in KernelTable::kernels.
+     */
+    template <typename FloatType>
+    size_t getLayoutIndex(const BlockContext<FloatType> &context)
+    {
+        if (context.numChannels == 1)
+            return 0;
+        if (context.numChannels == 2)
+            return (context.rightPhaseOffset == 0.0) ? 1 : 2;
+        return 3;
+    }
+
+    /**
+     * Returns the kernel for the given instruction set, shape and block.
+     *
+     * @param instructionSet The instruction set to use. See InstructionSets::select().
+     * @param shapeIndex The oscillator type parameter value (0 = sine, 1 = square, 2 = triangle).
+     * @param context The block to be processed. The layout is picked from its
+     *        channel count and right phase offset.
+     * @param interpolation Anything but LfoInterpolation::None picks a control
+     *        rate kernel for the sine shape. Ignored for the other shapes.
+     */
+    template <typename FloatType>
+    KernelFunction<FloatType> getKernel(InstructionSet instructionSet, size_t shapeIndex, const BlockContext<FloatType> &context,
+        LfoInterpolation interpolation = LfoInterpolation::None)
+    {
+        const KernelTable<FloatType> &table = getKernelTable<FloatType>(instructionSet);
+        if (shapeIndex == 0 && interpolation != LfoInterpolation::None)
+            return table.controlRateKernels[static_cast<size_t>(interpolation) - 1];
+
+        const auto &kernels = table.kernels;
+        return kernels[std::min(shapeIndex, kernels.size() - 1)][getLayoutIndex(context)];
+    }
+
+    /**
+     * Returns the shape renderer for the given instruction set and shape.
+     *
+     * @param instructionSet The instruction set to use. See InstructionSets::select().
+     * @param shapeIndex The oscillator type parameter value (0 = sine, 1 = square, 2 = triangle).
+     */
+    inline ShapeRenderFunction getShapeRenderer(InstructionSet instructionSet, size_t shapeIndex)
+    {
+        const auto &renderers = getKernelTable<double>(instructionSet).shapeRenderers;
+        return renderers[std::min(shapeIndex, renderers.size() - 1)];
+    }
+
+    /**
+     * Returns the control rate renderer for the given instruction set and
+     * interpolation, which must not be LfoInterpolation::None.
+     *
+     * @param instructionSet The instruction set to use. See InstructionSets::select().
+     * @param interpolation The interpolation.
+     */
+    inline ControlRateRenderFunction getControlRateRenderer(InstructionSet instructionSet, LfoInterpolation interpolation)
+    {
+        jassert(interpolation != LfoInterpolation::None);
+        const auto &renderers = getKernelTable<double>(instructionSet).controlRateRenderers;
+        return renderers[static_cast<size_t>(std::max(static_cast<int>(interpolation), 1)) - 1];
+    }
+}
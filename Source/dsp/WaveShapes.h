@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cmath>
+
+/**
+ * The wave shapes supported by the tremolo. Each shape is a pure function
+ * of the normalized phase (0.0 <= phase < 1.0) tracked by PhaseAccumulator
+ * and produces values in the range of -1.0 to 1.0. Every shape starts at
+ * -1.0 when the phase is 0.0, which means the tremolo starts out silent.
+ *
+ * Adding a new wave form takes a shape function here, a shape struct and
+ * its entries in the kernel tables in TremoloKernels.h (see
+ * TREMOLO_DECLARE_KERNELS and getKernelTable()), a choice in the oscillator
+ * parameter, and raising the clamp in
+ * TremoloAudioProcessor::getSelectedShapeIndex(), which only lets 0 to 2
+ * through. The scope's shape switch in
+ * TremoloAudioProcessor::pushScopePoints() needs a case too.
+ */
+namespace WaveShapes
+{
+    /**
+     * Sine wave shape.
+     */
+    inline double sine(double phase)
+    {
+        return -std::cos(phase * juce::MathConstants<double>::twoPi);
+    }
+
+    /**
+     * Square wave shape.
+     */
+    inline double square(double phase)
+    {
+        return (phase < 0.5) ? -1.0 : 1.0;
+    }
+
+    /**
+     * Triangle wave shape. Written without a branch so loops over it vectorize.
+     */
+    inline double triangle(double phase)
+    {
+        return 1.0 - 4.0 * std::abs(phase - 0.5);
+    }
+
+    //! Signature shared by all shape functions.
+    using ShapeFunction = double (*)(double phase);
+
+    //! Signature shared by all block renderers.
+    using BlockRenderFunction = void (*)(double startPhase, double phaseDelta, double *pDest, int numValues);
+
+    /**
+     * Fills the provided buffer with values of the given shape, starting at
+     * startPhase and advancing by phaseDelta with every value.
+     *
+     * Each phase is calculated directly from its index rather than
+     * accumulated, so the result matches PhaseAccumulator::advance() and the
+     * loop has no dependency from one value to the next.
+     *
+     * @param startPhase The phase of the first value.
+     * @param phaseDelta How much the phase advances with every value.
+     * @param pDest The buffer to fill. Must have room for at least numValues values.
+     * @param numValues The number of values to calculate.
+     */
+    template <ShapeFunction shape>
+    void renderBlock(double startPhase, double phaseDelta, double *pDest, int numValues)
+    {
+        for (int i = 0; i < numValues; ++i)
+        {
+            double phase = startPhase + phaseDelta * i;
+            phase = phase - std::floor(phase);
+            pDest[i] = shape(phase);
+        }
+    }
+}
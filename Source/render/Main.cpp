@@ -0,0 +1,278 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "dsp/TremoloAudioProcessor.h"
+#include "render/OfflineRenderer.h"
+#include "render/ParallelRenderer.h"
+#include "common/Trace.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    /**
+     * Prints how to use the render tool.
+     */
+    void printUsage()
+    {
+        std::cout
+            << "Usage: SKTremoloRender --input=<file> --output=<file> [options]\n"
+            << "       SKTremoloRender --input=<folder> --output=<folder> [options]\n"
+            << "\n"
+            << "Applies the SKTremolo effect to a WAV or AIFF file, or every one in a\n"
+            << "folder, without a host.\n"
+            << "\n"
+            << "Options:\n"
+            << "  --state=<file>      Restores parameters from a state blob saved by the plugin.\n"
+            << "  --save-state=<file> Saves the parameters used for the render as a state blob.\n"
+            << "  --chunk=<samples>   Samples per processing call. Defaults to " << OfflineRenderer::DEFAULT_CHUNK_SIZE << ".\n"
+            << "  --bits=<bits>       Output bit depth. Defaults to the input's.\n"
+            << "  --bpm=<bpm>         Tempo for tempo sync. Defaults to " << TempoSync::DEFAULT_BPM << ".\n"
+            << "  --threads=<count>   Renders on this many threads. 0 means one per core.\n"
+            << "                      Folders always render in parallel.\n"
+            << "  --trace=<file>      Writes a Chrome trace of the render. Needs a build with TREMOLO_TRACE=1.\n"
+            << "  --sine-precision=<tier>\n"
+            << "                      Fast, Standard, or High. How accurately the sine shape is\n"
+            << "                      calculated. Defaults to Standard.\n"
+            << "  --lfo-interpolation=<none|linear|cubic>\n"
+            << "                      Evaluates the sine shape every few samples and interpolates\n"
+            << "                      in between. Defaults to none (every sample).\n"
+            << "\n"
+            << "Parameters (applied after --state):\n"
+            << "  --speed=<1-40>      Speed in Hz.\n"
+            << "  --depth=<0-1>       Depth.\n"
+            << "  --gain=<0-1>        Gain.\n"
+            << "  --oscillator=<name> Sine, Square, or Triangle.\n"
+            << "  --spread=<0-180>    Stereo spread in degrees.\n"
+            << "  --sync=<on|off>     Tempo sync.\n"
+            << "  --division=<name>   Sync division, such as 1/4, 1/8., or 1/16T.\n"
+            << "  --bypass=<on|off>   Bypass.\n";
+    }
+
+    /**
+     * Returns the file named by the given option, relative to the current directory.
+     */
+    juce::File getFileForOption(const juce::ArgumentList &args, const juce::String &option)
+    {
+        const juce::String path = args.getValueForOption(option);
+        if (path.isEmpty())
+            throw std::runtime_error("Missing a file name for " + option.toStdString());
+
+        return juce::File::getCurrentWorkingDirectory().getChildFile(path);
+    }
+
+    /**
+     * Sets every parameter given on the command line, by parameter ID. Values
+     * are parsed the way the plugin parses typed in text.
+     */
+    void applyParameterOptions(juce::AudioProcessor &processor, const juce::ArgumentList &args)
+    {
+        for (juce::AudioProcessorParameter *pParameter : processor.getParameters())
+        {
+            auto *pRangedParameter = dynamic_cast<juce::RangedAudioParameter *>(pParameter);
+            if (!pRangedParameter)
+                continue;
+
+            const juce::String option = "--" + pRangedParameter->getParameterID();
+            if (!args.containsOption(option))
+                continue;
+
+            const juce::String text = args.getValueForOption(option);
+            if (auto *pChoice = dynamic_cast<juce::AudioParameterChoice *>(pRangedParameter))
+            {
+                if (!pChoice->choices.contains(text))
+                    throw std::runtime_error("Expected one of " + pChoice->choices.joinIntoString(", ").toStdString()
+                        + " for " + option.toStdString());
+            }
+
+            pRangedParameter->setValueNotifyingHost(pRangedParameter->getValueForText(text));
+        }
+    }
+
+    /**
+     * Returns the sine precision tier with the given name.
+     */
+    SinePrecision parseSinePrecision(const juce::String &text)
+    {
+        if (text.equalsIgnoreCase("Fast"))
+            return SinePrecision::Fast;
+        if (text.equalsIgnoreCase("Standard"))
+            return SinePrecision::Standard;
+        if (text.equalsIgnoreCase("High"))
+            return SinePrecision::High;
+
+        throw std::runtime_error("Expected one of Fast, Standard, High for --sine-precision");
+    }
+
+    /**
+     * Returns the LFO interpolation with the given name.
+     */
+    LfoInterpolation parseLfoInterpolation(const juce::String &text)
+    {
+        if (text.equalsIgnoreCase("none"))
+            return LfoInterpolation::None;
+        if (text.equalsIgnoreCase("linear"))
+            return LfoInterpolation::Linear;
+        if (text.equalsIgnoreCase("cubic"))
+            return LfoInterpolation::Cubic;
+
+        throw std::runtime_error("Expected one of none, linear, cubic for --lfo-interpolation");
+    }
+
+    /**
+     * Sets a processor up from the command line: the state from --state, if
+     * there is one, every parameter option on top of it, the sine precision,
+     * and the LFO interpolation. A parallel render runs this for every
+     * worker's processor too, so they all match the processor a single
+     * threaded render would use.
+     */
+    void setUpProcessor(TremoloAudioProcessor &processor, const juce::MemoryBlock &state, const juce::ArgumentList &args)
+    {
+        if (!state.isEmpty())
+            processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        applyParameterOptions(processor, args);
+
+        if (args.containsOption("--sine-precision"))
+            processor.setSinePrecision(parseSinePrecision(args.getValueForOption("--sine-precision")));
+        if (args.containsOption("--lfo-interpolation"))
+            processor.setLfoInterpolation(parseLfoInterpolation(args.getValueForOption("--lfo-interpolation")));
+    }
+
+    /**
+     * Returns the files to render in parallel. If the input is a folder, that's
+     * every WAV and AIFF file in it, written to the output folder under the
+     * same name.
+     */
+    std::vector<ParallelRenderer::Job> getParallelJobs(const juce::File &input, const juce::File &output)
+    {
+        if (!input.isDirectory())
+            return { { input, output } };
+
+        if (!output.createDirectory())
+            throw std::runtime_error("Couldn't create " + output.getFullPathName().toStdString());
+
+        std::vector<ParallelRenderer::Job> jobs;
+        for (const juce::File &file : input.findChildFiles(juce::File::findFiles, false, "*.wav;*.aif;*.aiff"))
+            jobs.push_back({ file, output.getChildFile(file.getFileName()) });
+
+        return jobs;
+    }
+
+    /**
+     * Writes out everything traced so far, if --trace was given.
+     */
+    void writeTrace(const juce::ArgumentList &args)
+    {
+        if (!args.containsOption("--trace"))
+            return;
+
+#if TREMOLO_TRACE
+        const juce::File traceFile = getFileForOption(args, "--trace");
+        if (!Trace::writeChromeJson(traceFile))
+            throw std::runtime_error("Couldn't write " + traceFile.getFullPathName().toStdString());
+#else
+        throw std::runtime_error("This build can't trace. Build it with TREMOLO_TRACE=1.");
+#endif
+    }
+}
+
+/**
+ * The entry point of the render tool.
+ *
+ * @since 2026 Oct 16
+ */
+int main(int argc, char *argv[])
+{
+    // The processor can make an editor, which needs the GUI side of JUCE set up.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.size() == 0 || args.containsOption("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    try
+    {
+        if (args.containsOption("--trace") && !TREMOLO_TRACE)
+            throw std::runtime_error("This build can't trace. Build it with TREMOLO_TRACE=1.");
+        TREMOLO_TRACE_PREPARE_THREAD();
+
+        juce::MemoryBlock state;
+        if (args.containsOption("--state"))
+        {
+            const juce::File stateFile = getFileForOption(args, "--state");
+            if (!stateFile.loadFileAsData(state))
+                throw std::runtime_error("Couldn't read " + stateFile.getFullPathName().toStdString());
+        }
+
+        // Also checks the parameter options, before any worker threads start.
+        TremoloAudioProcessor processor;
+        setUpProcessor(processor, state, args);
+
+        OfflineRenderer::Options options;
+        options.inputFile = getFileForOption(args, "--input");
+        options.outputFile = getFileForOption(args, "--output");
+        if (args.containsOption("--chunk"))
+            options.chunkSize = args.getValueForOption("--chunk").getIntValue();
+        if (args.containsOption("--bits"))
+            options.bitsPerSample = args.getValueForOption("--bits").getIntValue();
+        if (args.containsOption("--bpm"))
+            options.bpm = args.getValueForOption("--bpm").getDoubleValue();
+
+        if (args.containsOption("--save-state"))
+        {
+            juce::MemoryBlock savedState;
+            processor.getStateInformation(savedState);
+            const juce::File stateFile = getFileForOption(args, "--save-state");
+            if (!stateFile.replaceWithData(savedState.getData(), savedState.getSize()))
+                throw std::runtime_error("Couldn't write " + stateFile.getFullPathName().toStdString());
+        }
+
+        if (options.inputFile.isDirectory() || args.containsOption("--threads"))
+        {
+            ParallelRenderer::Options parallelOptions;
+            parallelOptions.blockSize = options.chunkSize;
+            parallelOptions.bitsPerSample = options.bitsPerSample;
+            parallelOptions.bpm = options.bpm;
+            if (args.containsOption("--threads"))
+                parallelOptions.numThreads = args.getValueForOption("--threads").getIntValue();
+
+            ParallelRenderer renderer([&state, &args](TremoloAudioProcessor &workerProcessor)
+            {
+                setUpProcessor(workerProcessor, state, args);
+            });
+            const ParallelRenderer::Result result = renderer.render(getParallelJobs(options.inputFile, options.outputFile),
+                parallelOptions);
+
+            std::cout << options.outputFile.getFullPathName() << ": "
+                      << result.numFiles << " files on " << result.numThreads << " threads\n"
+                      << "  Audio:   " << result.audioSeconds << " s\n"
+                      << "  Render:  " << result.totalSeconds << " s (" << result.getRealTimeFactor() << "x real time)\n";
+        }
+        else
+        {
+            OfflineRenderer renderer(processor);
+            const OfflineRenderer::Result result = renderer.render(options);
+
+            std::cout << options.outputFile.getFullPathName() << ": "
+                      << result.numChannels << " channels, " << result.numSamples << " samples at " << result.sampleRate << " Hz\n"
+                      << "  Audio:   " << result.getAudioSeconds() << " s\n"
+                      << "  Render:  " << result.totalSeconds << " s (" << result.getRealTimeFactor() << "x real time)\n"
+                      << "  Process: " << result.processSeconds << " s (" << result.getProcessRealTimeFactor() << "x real time)\n";
+        }
+
+        writeTrace(args);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * Stands in for a host's transport during offline renders. The render is
+ * always "playing" at a fixed tempo from the start of the file, so tempo
+ * synced tremolo lands in the same place every time, no matter how the file
+ * is split up.
+ *
+ * @since 2026 Oct 16
+ */
+class OfflinePlayHead : public juce::AudioPlayHead
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param sampleRate The sample rate of the file being rendered.
+     * @param bpm The tempo to report.
+     */
+    OfflinePlayHead(double sampleRate, double bpm)
+        : m_sampleRate(sampleRate),
+          m_bpm(bpm)
+    {
+    }
+
+    /**
+     * Moves the transport to the given sample. Call it before every block.
+     */
+    void setTimeInSamples(juce::int64 timeInSamples) { m_timeInSamples = timeInSamples; }
+
+    /**
+     * Returns the position of the block being processed.
+     */
+    juce::Optional<PositionInfo> getPosition() const override
+    {
+        const double timeInSeconds = m_timeInSamples / m_sampleRate;
+
+        PositionInfo position;
+        position.setIsPlaying(true);
+        position.setBpm(m_bpm);
+        position.setTimeInSamples(m_timeInSamples);
+        position.setTimeInSeconds(timeInSeconds);
+        position.setPpqPosition(timeInSeconds * (m_bpm / 60.0));
+        return position;
+    }
+
+private:
+
+    const double m_sampleRate;       //!< The sample rate of the render.
+    const double m_bpm;              //!< The tempo of the render.
+    juce::int64 m_timeInSamples = 0; //!< The position of the block being processed.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflinePlayHead)
+};
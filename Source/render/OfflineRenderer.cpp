@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "render/OfflineRenderer.h"
+#include "render/OfflinePlayHead.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    /**
+     * Returns the layout we ask the processor for, given the number of channels in a file.
+     */
+    juce::AudioChannelSet getChannelSet(int numChannels)
+    {
+        const juce::AudioChannelSet channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        return (channelSet.size() == numChannels) ? channelSet : juce::AudioChannelSet::discreteChannels(numChannels);
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+OfflineRenderer::OfflineRenderer(juce::AudioProcessor &processor)
+    : m_processor(processor)
+{
+    m_formatManager.registerBasicFormats();
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+OfflineRenderer::Result OfflineRenderer::render(const Options &options)
+{
+    const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+
+    if (options.chunkSize <= 0)
+        throw std::runtime_error("The chunk size must be at least 1.");
+
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> spReader = openInput(m_formatManager, options.inputFile);
+
+    Result result;
+    result.numSamples = spReader->lengthInSamples;
+    result.numChannels = static_cast<int>(spReader->numChannels);
+    result.sampleRate = spReader->sampleRate;
+
+    std::unique_ptr<juce::AudioFormatWriter> spWriter = createOutput(m_formatManager, options.outputFile, *spReader,
+        options.bitsPerSample);
+
+    OfflinePlayHead playHead(result.sampleRate, options.bpm);
+    prepareProcessor(m_processor, result.sampleRate, result.numChannels, options.chunkSize);
+    m_processor.setPlayHead(&playHead);
+
+    // From here on, nothing gets allocated. The last chunk is usually short,
+    // but shrinking the buffer keeps its memory.
+    juce::AudioBuffer<float> buffer(result.numChannels, options.chunkSize);
+    juce::MidiBuffer midiMessages;
+    bool succeeded = true;
+
+    for (juce::int64 position = 0; succeeded && (position < result.numSamples); position += options.chunkSize)
+    {
+        const int chunkSize = static_cast<int>(std::min<juce::int64>(options.chunkSize, result.numSamples - position));
+        buffer.setSize(result.numChannels, chunkSize, false, false, true);
+
+        succeeded = spReader->read(buffer.getArrayOfWritePointers(), result.numChannels, position, chunkSize);
+
+        const juce::int64 processStartTicks = juce::Time::getHighResolutionTicks();
+        playHead.setTimeInSamples(position);
+        m_processor.processBlock(buffer, midiMessages);
+        result.processSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - processStartTicks);
+
+        succeeded = succeeded && spWriter->writeFromAudioSampleBuffer(buffer, 0, chunkSize);
+    }
+
+    m_processor.releaseResources();
+    m_processor.setPlayHead(nullptr);
+    spWriter.reset(); // Finishes the file.
+
+    if (!succeeded)
+        throw std::runtime_error("Rendering " + options.inputFile.getFullPathName().toStdString() + " to "
+            + options.outputFile.getFullPathName().toStdString() + " failed.");
+
+    result.totalSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    return result;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+std::unique_ptr<juce::MemoryMappedAudioFormatReader> OfflineRenderer::openInput(juce::AudioFormatManager &formatManager,
+    const juce::File &inputFile)
+{
+    juce::AudioFormat *pFormat = formatManager.findFormatForFileExtension(inputFile.getFileExtension());
+    if (!pFormat)
+        throw std::runtime_error("Unsupported input format: " + inputFile.getFullPathName().toStdString());
+
+    // Memory mapping the whole input costs nothing but address space. The OS
+    // only reads the pages we touch, so the file streams in as the render
+    // gets to it.
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> spReader(pFormat->createMemoryMappedReader(inputFile));
+    if (!spReader || !spReader->mapEntireFile())
+        throw std::runtime_error("Couldn't open " + inputFile.getFullPathName().toStdString());
+
+    return spReader;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+std::unique_ptr<juce::AudioFormatWriter> OfflineRenderer::createOutput(juce::AudioFormatManager &formatManager,
+    const juce::File &outputFile, const juce::AudioFormatReader &input, int bitsPerSample)
+{
+    // The output goes wherever the extension says, replacing what's there.
+    juce::AudioFormat *pFormat = formatManager.findFormatForFileExtension(outputFile.getFileExtension());
+    if (!pFormat)
+        throw std::runtime_error("Unsupported output format: " + outputFile.getFullPathName().toStdString());
+
+    auto spOutputStream = std::make_unique<juce::FileOutputStream>(outputFile);
+    if (spOutputStream->failedToOpen() || !spOutputStream->setPosition(0) || spOutputStream->truncate().failed())
+        throw std::runtime_error("Couldn't write " + outputFile.getFullPathName().toStdString());
+
+    if (bitsPerSample <= 0)
+        bitsPerSample = static_cast<int>(input.bitsPerSample);
+
+    std::unique_ptr<juce::AudioFormatWriter> spWriter(pFormat->createWriterFor(spOutputStream.get(),
+        input.sampleRate, input.numChannels, bitsPerSample, input.metadataValues, 0));
+    if (!spWriter)
+        throw std::runtime_error("Can't write " + std::to_string(input.numChannels) + " channels of "
+            + std::to_string(bitsPerSample) + "-bit audio to " + outputFile.getFullPathName().toStdString());
+
+    spOutputStream.release(); // The writer owns it now.
+    return spWriter;
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void OfflineRenderer::prepareProcessor(juce::AudioProcessor &processor, double sampleRate, int numChannels, int blockSize)
+{
+    // Set the processor up the way a host would.
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(getChannelSet(numChannels));
+    layout.outputBuses.add(getChannelSet(numChannels));
+    if (!processor.setBusesLayout(layout))
+        throw std::runtime_error("The processor doesn't support " + std::to_string(numChannels) + " channels.");
+
+    processor.setNonRealtime(true);
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+}
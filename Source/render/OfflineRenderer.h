@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "dsp/TempoSync.h"
+
+#include <JuceHeader.h>
+#include <memory>
+
+/**
+ * Runs a TremoloAudioProcessor over an audio file, with no host, as fast as
+ * the machine allows. Meant for batch processing archives of recordings.
+ *
+ * The input is read through a memory-mapped reader, so the OS streams the
+ * file in as the render gets to it, and the output is written as we go. The
+ * audio passes through the processor in large, fixed-size chunks. Everything
+ * the render needs is allocated up front, so nothing is allocated per chunk.
+ *
+ * The processor is used as is. Set up its parameters (or restore its state)
+ * before calling render().
+ *
+ * @since 2026 Oct 16
+ */
+class OfflineRenderer
+{
+public:
+
+    //! The number of samples passed to the processor at a time, unless told otherwise.
+    static constexpr int DEFAULT_CHUNK_SIZE = 65536;
+
+    /**
+     * What to render and how.
+     */
+    struct Options
+    {
+        juce::File inputFile;                  //!< A WAV or AIFF file.
+        juce::File outputFile;                 //!< WAV or AIFF, picked by extension. Replaced if it exists.
+        int chunkSize = DEFAULT_CHUNK_SIZE;    //!< The number of samples per processBlock() call.
+        int bitsPerSample = 0;                 //!< The output's bit depth. 0 keeps the input's.
+        double bpm = TempoSync::DEFAULT_BPM;   //!< The tempo reported to the processor, for tempo sync.
+    };
+
+    /**
+     * What a render did and how long it took.
+     */
+    struct Result
+    {
+        juce::int64 numSamples = 0;   //!< The number of samples per channel.
+        int numChannels = 0;          //!< The number of channels.
+        double sampleRate = 0.0;      //!< The sample rate of the input and output.
+        double totalSeconds = 0.0;    //!< Wall clock time for the whole render, reading and writing included.
+        double processSeconds = 0.0;  //!< Wall clock time spent inside processBlock().
+
+        /**
+         * Returns how long the audio lasts, in seconds.
+         */
+        double getAudioSeconds() const { return (sampleRate > 0.0) ? numSamples / sampleRate : 0.0; }
+
+        /**
+         * Returns how many times faster than real time the whole render ran.
+         */
+        double getRealTimeFactor() const { return (totalSeconds > 0.0) ? getAudioSeconds() / totalSeconds : 0.0; }
+
+        /**
+         * Returns how many times faster than real time the processor alone ran.
+         */
+        double getProcessRealTimeFactor() const { return (processSeconds > 0.0) ? getAudioSeconds() / processSeconds : 0.0; }
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param processor The processor to render with. It must outlive the
+     *        renderer. Its bus layout, sample rate, and play head are changed
+     *        to suit each render.
+     */
+    explicit OfflineRenderer(juce::AudioProcessor &processor);
+
+    /**
+     * Renders the input file to the output file.
+     *
+     * @throws std::runtime_error If a file can't be read or written, or the
+     *         processor doesn't support the input's channel layout.
+     */
+    Result render(const Options &options);
+
+    /**
+     * Opens a WAV or AIFF file for reading through a memory-mapped reader.
+     *
+     * @throws std::runtime_error If the file can't be opened.
+     */
+    static std::unique_ptr<juce::MemoryMappedAudioFormatReader> openInput(juce::AudioFormatManager &formatManager,
+        const juce::File &inputFile);
+
+    /**
+     * Creates a writer for the output file, replacing it if it exists, with
+     * the same sample rate, channels, and metadata as the input.
+     *
+     * @param bitsPerSample The output's bit depth. 0 keeps the input's.
+     * @throws std::runtime_error If the file can't be written.
+     */
+    static std::unique_ptr<juce::AudioFormatWriter> createOutput(juce::AudioFormatManager &formatManager,
+        const juce::File &outputFile, const juce::AudioFormatReader &input, int bitsPerSample);
+
+    /**
+     * Sets the processor up for a file the way a host would, and prepares it
+     * to play.
+     *
+     * @throws std::runtime_error If the processor doesn't support the number of channels.
+     */
+    static void prepareProcessor(juce::AudioProcessor &processor, double sampleRate, int numChannels, int blockSize);
+
+private:
+
+    juce::AudioProcessor &m_processor;       //!< The processor we render with.
+    juce::AudioFormatManager m_formatManager; //!< Knows how to read and write WAV and AIFF.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
@@ -0,0 +1,481 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "render/ParallelRenderer.h"
+#include "render/OfflinePlayHead.h"
+#include "dsp/TremoloAudioProcessor.h"
+#include "common/Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    using ChunkBuffer = juce::AudioBuffer<float>;
+
+    /**
+     * A few blocks of one file, rendered in one go by one worker.
+     */
+    struct Task
+    {
+        size_t jobIndex = 0; //!< The file.
+        int taskIndex = 0;   //!< Which of the file's tasks, counting from the start of the file.
+    };
+
+    /**
+     * Everything about one file that's shared between the workers.
+     */
+    struct FileState
+    {
+        juce::int64 numSamples = 0; //!< Length of the file, in samples per channel.
+        int numTasks = 0;           //!< The number of tasks the file is split into.
+
+        juce::SpinLock lock;                                 //!< Guards everything below.
+        std::vector<std::unique_ptr<ChunkBuffer>> finished;  //!< Finished tasks waiting to be written, by task index.
+        std::atomic<int> nextTaskToWrite{ 0 };               //!< Tasks before this one have been written. Read without the lock.
+        bool isWriting = false;                              //!< True while some worker is writing finished tasks.
+        std::unique_ptr<juce::AudioFormatWriter> spWriter;   //!< Created when the first task is written.
+    };
+
+    /**
+     * One worker's queue of tasks. The worker takes tasks off the front.
+     * Other workers steal from the back once they run out of their own.
+     */
+    struct TaskQueue
+    {
+        juce::SpinLock lock;     //!< Guards the tasks.
+        std::deque<Task> tasks;  //!< The tasks, in the order the worker takes them.
+    };
+
+    /**
+     * All the state of one render, shared by the workers.
+     */
+    class RenderSession
+    {
+    public:
+
+        using Job = ParallelRenderer::Job;
+
+        RenderSession(const std::vector<Job> &jobs, const ParallelRenderer::Options &options,
+            const ParallelRenderer::ProcessorSetup &setUpProcessor, int numThreads)
+            : m_jobs(jobs),
+              m_options(options),
+              m_setUpProcessor(setUpProcessor),
+              m_files(jobs.size()),
+              m_queues(static_cast<size_t>(numThreads)),
+              m_maxTasksAhead((options.maxTasksAhead > 0) ? options.maxTasksAhead : 2 * numThreads)
+        {
+        }
+
+        /**
+         * Opens every input to find its length and splits it into tasks. The
+         * tasks are dealt out round robin, so the workers all start at the
+         * front of the first file and finished tasks can be written right
+         * away instead of piling up.
+         *
+         * @return How long all files last together, in seconds.
+         */
+        double planTasks()
+        {
+            juce::AudioFormatManager formatManager;
+            formatManager.registerBasicFormats();
+
+            const juce::int64 taskSize = static_cast<juce::int64>(m_options.blockSize) * m_options.blocksPerTask;
+            double audioSeconds = 0.0;
+            size_t queueIndex = 0;
+
+            for (size_t jobIndex = 0; jobIndex < m_jobs.size(); ++jobIndex)
+            {
+                const std::unique_ptr<juce::MemoryMappedAudioFormatReader> spReader =
+                    OfflineRenderer::openInput(formatManager, m_jobs[jobIndex].inputFile);
+
+                FileState &file = m_files[jobIndex];
+                file.numSamples = spReader->lengthInSamples;
+                file.numTasks = static_cast<int>((file.numSamples + taskSize - 1) / taskSize);
+                file.finished.resize(static_cast<size_t>(file.numTasks));
+                audioSeconds += file.numSamples / spReader->sampleRate;
+
+                // Nothing to split up, but there should still be a file at the end.
+                if (file.numTasks == 0)
+                    OfflineRenderer::createOutput(formatManager, m_jobs[jobIndex].outputFile, *spReader, m_options.bitsPerSample);
+
+                for (int taskIndex = 0; taskIndex < file.numTasks; ++taskIndex)
+                {
+                    m_queues[queueIndex].tasks.push_back({ jobIndex, taskIndex });
+                    queueIndex = (queueIndex + 1) % m_queues.size();
+                }
+                m_numTasksLeft += file.numTasks;
+            }
+
+            return audioSeconds;
+        }
+
+        /**
+         * Runs one worker until there's nothing left to do.
+         */
+        void runWorker(size_t workerIndex)
+        {
+            try
+            {
+                TREMOLO_TRACE_PREPARE_THREAD();
+                Worker worker(m_setUpProcessor);
+                Task task;
+
+                while (!m_hasFailed && takeTask(workerIndex, task))
+                    renderTask(worker, task);
+            }
+            catch (const std::exception &e)
+            {
+                fail(e.what());
+            }
+        }
+
+        /**
+         * Throws the first error any worker ran into, if any.
+         */
+        void throwIfFailed()
+        {
+            if (m_hasFailed)
+                throw std::runtime_error(m_errorMessage);
+        }
+
+    private:
+
+        /**
+         * A worker's own processor and the file it has open.
+         */
+        struct Worker
+        {
+            explicit Worker(const ParallelRenderer::ProcessorSetup &setUpProcessor)
+            {
+                setUpProcessor(processor);
+                formatManager.registerBasicFormats();
+            }
+
+            TremoloAudioProcessor processor;                               //!< Renders this worker's tasks.
+            juce::AudioFormatManager formatManager;                        //!< Opens the inputs.
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> spReader; //!< The input of the file being worked on.
+            std::unique_ptr<OfflinePlayHead> spPlayHead;                   //!< The transport of the file being worked on.
+            size_t jobIndex = SIZE_MAX;                                    //!< The file being worked on.
+            juce::int64 position = 0;                                      //!< Where the processor left off in that file.
+            ChunkBuffer preRollBuffer;                                     //!< Audio processed only to catch up after a seek.
+            std::vector<float *> channelPointers;                          //!< Points into the block being processed.
+            juce::MidiBuffer midiMessages;                                 //!< Always empty. The processor ignores MIDI.
+        };
+
+        /**
+         * Takes the next task that's ready (see isReady()). If there are
+         * tasks left but none of them are ready, waits for the writing to
+         * catch up.
+         *
+         * @return False once there's nothing left anywhere, or a worker failed.
+         */
+        bool takeTask(size_t workerIndex, Task &task)
+        {
+            while (m_numTasksLeft > 0 && !m_hasFailed)
+            {
+                if (tryTakeTask(workerIndex, task))
+                    return true;
+
+                std::this_thread::yield();
+            }
+            return false;
+        }
+
+        /**
+         * Takes the next task off the worker's own queue, or steals one from
+         * the back of another worker's queue. If a task isn't ready, the one
+         * at the other end of the queue is tried instead.
+         *
+         * Can't get stuck. Every queue is in file and task order, so the first
+         * task not yet taken is at the front of some queue, and it becomes
+         * ready once the tasks before it, which are all being rendered, are
+         * written.
+         *
+         * @return False if there's no task that's ready.
+         */
+        bool tryTakeTask(size_t workerIndex, Task &task)
+        {
+            for (size_t i = 0; i < m_queues.size(); ++i)
+            {
+                const bool isOwnQueue = (i == 0);
+                TaskQueue &queue = m_queues[(workerIndex + i) % m_queues.size()];
+
+                const juce::SpinLock::ScopedLockType lock(queue.lock);
+                if (queue.tasks.empty())
+                    continue;
+
+                if (!isOwnQueue && isReady(queue.tasks.back()))
+                {
+                    task = queue.tasks.back();
+                    queue.tasks.pop_back();
+                }
+                else if (isReady(queue.tasks.front()))
+                {
+                    task = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+                else
+                {
+                    continue;
+                }
+
+                --m_numTasksLeft;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Returns true if the task isn't too far ahead of what's been written
+         * of its file. Finished tasks are kept in memory until they're
+         * written, so this keeps a slow task or a slow disk from piling up
+         * the rest of the file in memory.
+         */
+        bool isReady(const Task &task) const
+        {
+            return task.taskIndex - m_files[task.jobIndex].nextTaskToWrite.load() < m_maxTasksAhead;
+        }
+
+        /**
+         * Renders one task and hands it over to be written.
+         */
+        void renderTask(Worker &worker, const Task &task)
+        {
+            const FileState &file = m_files[task.jobIndex];
+            const int blockSize = m_options.blockSize;
+
+            if (worker.jobIndex != task.jobIndex)
+                openFile(worker, task.jobIndex);
+
+            const int numChannels = static_cast<int>(worker.spReader->numChannels);
+            const juce::int64 taskSize = static_cast<juce::int64>(blockSize) * m_options.blocksPerTask;
+            const juce::int64 start = task.taskIndex * taskSize;
+            const juce::int64 end = std::min(start + taskSize, file.numSamples);
+
+            // Unless we just rendered the audio right before this task, the
+            // processor needs to catch up. The pre-roll starts on a block
+            // boundary, so every block lines up with an uninterrupted render.
+            if (worker.position != start)
+            {
+                const juce::int64 preRollBlocks = (worker.processor.getSeekPreRollSamples() + blockSize - 1) / blockSize;
+                const juce::int64 preRollStart = std::max<juce::int64>(start - preRollBlocks * blockSize, 0);
+
+                worker.processor.seek(preRollStart);
+                for (juce::int64 position = preRollStart; position < start; position += blockSize)
+                {
+                    worker.preRollBuffer.setSize(numChannels, blockSize, false, false, true);
+                    processBlock(worker, worker.preRollBuffer.getArrayOfWritePointers(), position, blockSize);
+                }
+            }
+
+            std::unique_ptr<ChunkBuffer> spChunk = acquireBuffer(numChannels, static_cast<int>(end - start));
+            for (juce::int64 position = start; position < end; position += blockSize)
+            {
+                const int numSamples = static_cast<int>(std::min<juce::int64>(blockSize, end - position));
+                for (int channel = 0; channel < numChannels; ++channel)
+                    worker.channelPointers[static_cast<size_t>(channel)] = spChunk->getWritePointer(channel, static_cast<int>(position - start));
+
+                processBlock(worker, worker.channelPointers.data(), position, numSamples);
+            }
+            worker.position = end;
+
+            finishTask(task, std::move(spChunk));
+        }
+
+        /**
+         * Switches a worker over to another file.
+         */
+        void openFile(Worker &worker, size_t jobIndex)
+        {
+            worker.jobIndex = SIZE_MAX;
+            worker.spReader = OfflineRenderer::openInput(worker.formatManager, m_jobs[jobIndex].inputFile);
+
+            const double sampleRate = worker.spReader->sampleRate;
+            const int numChannels = static_cast<int>(worker.spReader->numChannels);
+
+            worker.processor.setPlayHead(nullptr);
+            worker.spPlayHead = std::make_unique<OfflinePlayHead>(sampleRate, m_options.bpm);
+            OfflineRenderer::prepareProcessor(worker.processor, sampleRate, numChannels, m_options.blockSize);
+            worker.processor.setPlayHead(worker.spPlayHead.get());
+
+            worker.preRollBuffer.setSize(numChannels, m_options.blockSize);
+            worker.channelPointers.resize(static_cast<size_t>(numChannels));
+            worker.jobIndex = jobIndex;
+            worker.position = 0; // prepareToPlay() puts the processor at the start of the file.
+        }
+
+        /**
+         * Reads and processes one block in place.
+         */
+        void processBlock(Worker &worker, float* const* pChannels, juce::int64 position, int numSamples)
+        {
+            const int numChannels = static_cast<int>(worker.spReader->numChannels);
+            if (!worker.spReader->read(pChannels, numChannels, position, numSamples))
+                throw std::runtime_error("Couldn't read " + m_jobs[worker.jobIndex].inputFile.getFullPathName().toStdString());
+
+            ChunkBuffer block(pChannels, numChannels, numSamples);
+            worker.spPlayHead->setTimeInSamples(position);
+            worker.processor.processBlock(block, worker.midiMessages);
+        }
+
+        /**
+         * Hands a finished task over to be written. If it's next in line, this
+         * worker writes it, along with any tasks after it that finished early.
+         * Otherwise, whoever finishes the task that's next in line does.
+         */
+        void finishTask(const Task &task, std::unique_ptr<ChunkBuffer> spChunk)
+        {
+            FileState &file = m_files[task.jobIndex];
+            {
+                const juce::SpinLock::ScopedLockType lock(file.lock);
+                file.finished[static_cast<size_t>(task.taskIndex)] = std::move(spChunk);
+                if (file.isWriting)
+                    return;
+                file.isWriting = true;
+            }
+
+            for (;;)
+            {
+                std::unique_ptr<ChunkBuffer> spNext;
+                {
+                    const juce::SpinLock::ScopedLockType lock(file.lock);
+                    if (file.nextTaskToWrite == file.numTasks || !file.finished[static_cast<size_t>(file.nextTaskToWrite)])
+                    {
+                        file.isWriting = false;
+                        return;
+                    }
+                    spNext = std::move(file.finished[static_cast<size_t>(file.nextTaskToWrite)]);
+                }
+
+                // Only one worker at a time gets here for any one file, so the
+                // writer is ours until we say otherwise.
+                const Job &job = m_jobs[task.jobIndex];
+                if (!file.spWriter)
+                {
+                    juce::AudioFormatManager formatManager;
+                    formatManager.registerBasicFormats();
+                    const std::unique_ptr<juce::MemoryMappedAudioFormatReader> spReader =
+                        OfflineRenderer::openInput(formatManager, job.inputFile);
+                    file.spWriter = OfflineRenderer::createOutput(formatManager, job.outputFile, *spReader, m_options.bitsPerSample);
+                }
+
+                if (!file.spWriter->writeFromAudioSampleBuffer(*spNext, 0, spNext->getNumSamples()))
+                    throw std::runtime_error("Couldn't write " + job.outputFile.getFullPathName().toStdString());
+                releaseBuffer(std::move(spNext));
+
+                const juce::SpinLock::ScopedLockType lock(file.lock);
+                if (++file.nextTaskToWrite == file.numTasks)
+                    file.spWriter.reset(); // Finishes the file.
+            }
+        }
+
+        /**
+         * Returns a buffer for a task's output. Buffers are recycled, so once
+         * the render is under way, nothing gets allocated.
+         */
+        std::unique_ptr<ChunkBuffer> acquireBuffer(int numChannels, int numSamples)
+        {
+            std::unique_ptr<ChunkBuffer> spBuffer;
+            {
+                const juce::SpinLock::ScopedLockType lock(m_freeBuffersLock);
+                if (!m_freeBuffers.empty())
+                {
+                    spBuffer = std::move(m_freeBuffers.back());
+                    m_freeBuffers.pop_back();
+                }
+            }
+
+            if (!spBuffer)
+                spBuffer = std::make_unique<ChunkBuffer>();
+
+            spBuffer->setSize(numChannels, numSamples, false, false, true);
+            return spBuffer;
+        }
+
+        /**
+         * Puts a buffer back for acquireBuffer() to hand out again.
+         */
+        void releaseBuffer(std::unique_ptr<ChunkBuffer> spBuffer)
+        {
+            const juce::SpinLock::ScopedLockType lock(m_freeBuffersLock);
+            m_freeBuffers.push_back(std::move(spBuffer));
+        }
+
+        /**
+         * Remembers the first error and tells every worker to stop.
+         */
+        void fail(const std::string &message)
+        {
+            const juce::SpinLock::ScopedLockType lock(m_errorLock);
+            if (!m_hasFailed)
+                m_errorMessage = message;
+            m_hasFailed = true;
+        }
+
+        const std::vector<Job> &m_jobs;                 //!< The files to render.
+        const ParallelRenderer::Options &m_options;     //!< How to render them.
+        const ParallelRenderer::ProcessorSetup &m_setUpProcessor; //!< Sets up every worker's processor.
+
+        std::vector<FileState> m_files;                 //!< Shared state of every file, in the same order as m_jobs.
+        std::vector<TaskQueue> m_queues;                //!< One queue of tasks per worker.
+        std::atomic<int> m_numTasksLeft{ 0 };           //!< Tasks not taken off a queue yet.
+        const int m_maxTasksAhead;                      //!< How far ahead of the writing a file's tasks may be rendered.
+
+        juce::SpinLock m_freeBuffersLock;                         //!< Guards m_freeBuffers.
+        std::vector<std::unique_ptr<ChunkBuffer>> m_freeBuffers;  //!< Buffers ready to be reused.
+
+        std::atomic<bool> m_hasFailed{ false }; //!< Set when any worker runs into an error.
+        juce::SpinLock m_errorLock;             //!< Guards m_errorMessage.
+        std::string m_errorMessage;             //!< The first error any worker ran into.
+    };
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+ParallelRenderer::ParallelRenderer(ProcessorSetup setUpProcessor)
+    : m_setUpProcessor(std::move(setUpProcessor))
+{
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+ParallelRenderer::Result ParallelRenderer::render(const std::vector<Job> &jobs, const Options &options)
+{
+    const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+
+    if (options.blockSize <= 0 || options.blocksPerTask <= 0)
+        throw std::runtime_error("The block size and blocks per task must be at least 1.");
+
+    Result result;
+    result.numFiles = static_cast<int>(jobs.size());
+    result.numThreads = (options.numThreads > 0) ? options.numThreads : juce::SystemStats::getNumCpus();
+
+    if (!m_setUpProcessor)
+        throw std::runtime_error("The parallel renderer needs a way to set up its processors.");
+
+    RenderSession session(jobs, options, m_setUpProcessor, result.numThreads);
+    result.audioSeconds = session.planTasks();
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < result.numThreads; ++thread)
+        threads.emplace_back([&session, thread] { session.runWorker(static_cast<size_t>(thread)); });
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    session.throwIfFailed();
+
+    result.totalSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    return result;
+}
@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "dsp/TempoSync.h"
+#include "render/OfflineRenderer.h"
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+class TremoloAudioProcessor;
+
+/**
+ * Renders files on every core at once. Like OfflineRenderer, but each file
+ * is split into tasks of a few blocks each, and the tasks of all files are
+ * shared out between worker threads that steal from each other when they
+ * run out.
+ *
+ * That works because the tremolo is just a gain once we know the phase, and
+ * TremoloAudioProcessor::seek() can put the phase exactly where it would be
+ * at any sample. Each task seeks to its first sample, processes a little
+ * audio before it to catch up on the rest of the processor's state, and then
+ * processes its own blocks. The output is bit for bit identical to an
+ * OfflineRenderer render with a chunk size of blockSize.
+ *
+ * Every worker has its own TremoloAudioProcessor, set up by the same
+ * function. A state blob alone won't do, since it leaves out bypass, which
+ * belongs to the host.
+ *
+ * Finished tasks are written out in order, by whichever worker finishes the
+ * task that's next in line. Until then they wait in memory, so workers only
+ * take tasks up to maxTasksAhead past the one being written. That keeps the
+ * memory a render needs fixed, no matter how long the files are.
+ *
+ * @since 2026 Oct 16
+ */
+class ParallelRenderer
+{
+public:
+
+    //! The number of blocks in a task, unless told otherwise.
+    static constexpr int DEFAULT_BLOCKS_PER_TASK = 16;
+
+    /**
+     * Sets up one worker's processor, parameters and all. Called once per
+     * worker, on the worker's thread, before it renders anything. It should
+     * set the processor up exactly the way a single threaded render's
+     * processor would be, or the outputs won't match.
+     */
+    using ProcessorSetup = std::function<void(TremoloAudioProcessor &processor)>;
+
+    /**
+     * One file to render.
+     */
+    struct Job
+    {
+        juce::File inputFile;  //!< A WAV or AIFF file.
+        juce::File outputFile; //!< WAV or AIFF, picked by extension. Replaced if it exists.
+    };
+
+    /**
+     * How to render.
+     */
+    struct Options
+    {
+        int blockSize = OfflineRenderer::DEFAULT_CHUNK_SIZE; //!< The number of samples per processBlock() call.
+        int blocksPerTask = DEFAULT_BLOCKS_PER_TASK;         //!< The number of blocks a worker renders in one go.
+        int numThreads = 0;                                  //!< The number of worker threads. 0 means one per core.
+        int maxTasksAhead = 0;                               //!< How many tasks of a file may be rendered ahead of the one being written. 0 means two per thread.
+        int bitsPerSample = 0;                               //!< The output's bit depth. 0 keeps the input's.
+        double bpm = TempoSync::DEFAULT_BPM;                 //!< The tempo reported to the processor, for tempo sync.
+    };
+
+    /**
+     * What a render did and how long it took.
+     */
+    struct Result
+    {
+        int numFiles = 0;            //!< The number of files rendered.
+        double audioSeconds = 0.0;   //!< How long all files last together, in seconds.
+        double totalSeconds = 0.0;   //!< Wall clock time for the whole render.
+        int numThreads = 0;          //!< The number of worker threads used.
+
+        /**
+         * Returns how many times faster than real time the render ran.
+         */
+        double getRealTimeFactor() const { return (totalSeconds > 0.0) ? audioSeconds / totalSeconds : 0.0; }
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param setUpProcessor Sets up every worker's processor.
+     */
+    explicit ParallelRenderer(ProcessorSetup setUpProcessor);
+
+    /**
+     * Renders every job. Returns once all of them are done.
+     *
+     * @throws std::runtime_error If any file can't be read or written. The
+     *         other files may or may not have been rendered.
+     */
+    Result render(const std::vector<Job> &jobs, const Options &options);
+
+private:
+
+    const ProcessorSetup m_setUpProcessor; //!< Sets up every worker's processor.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParallelRenderer)
+};
@@ -0,0 +1,99 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "ui/LfoScope.h"
+
+/**
+ * @since 2026 Oct 16
+ */
+LfoScope::LfoScope(ScopeFifo &fifo, juce::Colour foregroundColor) :
+    m_fifo(fifo),
+    m_pulledPoints(static_cast<size_t>(ScopeFifo::CAPACITY)),
+    m_history(static_cast<size_t>(HISTORY_SIZE)),
+    m_foregroundColor(foregroundColor)
+{
+    setInterceptsMouseClicks(false, false);
+
+    // Anything left over from the last time the editor was open is stale.
+    m_fifo.discard();
+    m_fifo.setEnabled(true);
+    startTimerHz(FRAME_RATE_HZ);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+LfoScope::~LfoScope()
+{
+    m_fifo.setEnabled(false);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void LfoScope::paint(juce::Graphics &g)
+{
+    g.setColour(m_foregroundColor.withAlpha(0.25f));
+    g.fillPath(m_envelopePath);
+
+    g.setColour(m_foregroundColor);
+    g.strokePath(m_modulationPath, juce::PathStrokeType(1.5f));
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void LfoScope::resized()
+{
+    rebuildPaths();
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void LfoScope::timerCallback()
+{
+    const int numPulled = m_fifo.pull(m_pulledPoints.data(), static_cast<int>(m_pulledPoints.size()));
+    if (numPulled == 0)
+        return;
+
+    // The history is a ring. The newest point overwrites the oldest.
+    for (int i = 0; i < numPulled; ++i)
+    {
+        m_history[m_historyStart] = m_pulledPoints[static_cast<size_t>(i)];
+        m_historyStart = (m_historyStart + 1) % m_history.size();
+    }
+
+    rebuildPaths();
+    repaint();
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void LfoScope::rebuildPaths()
+{
+    const auto bounds = getLocalBounds().toFloat().reduced(1.0f);
+    const float xStep = bounds.getWidth() / (HISTORY_SIZE - 1);
+    const auto toY = [&bounds](float value) { return bounds.getBottom() - juce::jlimit(0.0f, 1.0f, value) * bounds.getHeight(); };
+
+    m_modulationPath.clear();
+    m_envelopePath.clear();
+    m_envelopePath.startNewSubPath(bounds.getBottomLeft());
+
+    for (size_t i = 0; i < m_history.size(); ++i)
+    {
+        const ScopeFifo::Point &point = m_history[(m_historyStart + i) % m_history.size()];
+        const float x = bounds.getX() + xStep * static_cast<float>(i);
+
+        if (i == 0)
+            m_modulationPath.startNewSubPath(x, toY(point.modulation));
+        else
+            m_modulationPath.lineTo(x, toY(point.modulation));
+        m_envelopePath.lineTo(x, toY(point.envelope));
+    }
+
+    m_envelopePath.lineTo(bounds.getBottomRight());
+    m_envelopePath.closeSubPath();
+}
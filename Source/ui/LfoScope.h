@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "dsp/ScopeFifo.h"
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * A scrolling picture of the last couple of seconds of tremolo: the
+ * modulation curve as a line, and the envelope of the output filled in
+ * underneath it.
+ *
+ * The scope turns the processor's ScopeFifo on for as long as it exists,
+ * and drains it on a timer capped at FRAME_RATE_HZ. The paths are only
+ * rebuilt when new points have arrived or the size changes, so paint()
+ * just draws what's cached.
+ */
+class LfoScope : public juce::Component,
+                 private juce::Timer
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param fifo Where the points come from.
+     * @param foregroundColor The curve and envelope.
+     */
+    LfoScope(ScopeFifo &fifo, juce::Colour foregroundColor);
+
+    /**
+     * Destructor. Turns the processor's scope back off.
+     */
+    ~LfoScope() override;
+
+    /**
+     * Draws the cached paths.
+     */
+    void paint(juce::Graphics &g) override;
+
+    /**
+     * Rebuilds the paths for the new size.
+     */
+    void resized() override;
+
+private:
+
+    /**
+     * Moves any new points into the history and repaints if there were any.
+     */
+    void timerCallback() override;
+
+    /**
+     * Rebuilds m_modulationPath and m_envelopePath from the history.
+     */
+    void rebuildPaths();
+
+    static constexpr int FRAME_RATE_HZ = 30;  //!< The most often the scope redraws.
+    static constexpr int HISTORY_SIZE = 500;  //!< Points shown across the width. Two seconds at ScopeFifo::POINTS_PER_SECOND.
+
+    ScopeFifo &m_fifo;                              //!< Where the points come from.
+    std::vector<ScopeFifo::Point> m_pulledPoints;   //!< Points pulled from the FIFO this frame.
+    std::vector<ScopeFifo::Point> m_history;        //!< The points shown, oldest first from m_historyStart.
+    size_t m_historyStart = 0;                      //!< The oldest point in m_history.
+
+    juce::Path m_modulationPath; //!< The modulation curve, as of the last rebuild.
+    juce::Path m_envelopePath;   //!< The output envelope, as of the last rebuild.
+
+    const juce::Colour m_foregroundColor; //!< The curve and envelope.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LfoScope)
+};
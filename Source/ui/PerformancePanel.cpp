@@ -0,0 +1,114 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#include "ui/PerformancePanel.h"
+
+/**
+ * @since 2026 Oct 16
+ */
+PerformancePanel::PerformancePanel(PerformanceMonitor &monitor, juce::Colour backgroundColor, juce::Colour foregroundColor) :
+    m_monitor(monitor),
+    m_backgroundColor(backgroundColor),
+    m_foregroundColor(foregroundColor)
+{
+    m_resetButton.onClick = [this]() { m_monitor.reset(); };
+    addAndMakeVisible(m_resetButton);
+
+    m_closeButton.onClick = [this]() { setVisible(false); };
+    addAndMakeVisible(m_closeButton);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void PerformancePanel::paint(juce::Graphics &g)
+{
+    g.fillAll(m_backgroundColor);
+    g.setColour(m_foregroundColor);
+    g.setFont(juce::FontOptions(15.0f));
+
+    auto bounds = getLocalBounds().reduced(20);
+    bounds.removeFromBottom(35); // Room for the buttons.
+    const auto toMicroseconds = [](double seconds) { return juce::String(seconds * 1e6, 1) + " us"; };
+    const auto toPercent = [](double fraction) { return juce::String(fraction * 100.0, 1) + "%"; };
+
+    // The numbers, one per line, on the left.
+    const std::pair<juce::String, juce::String> lines[] =
+    {
+        { "Blocks",         juce::String(static_cast<juce::int64>(m_snapshot.numBlocks)) },
+        { "Last block",     toMicroseconds(m_snapshot.lastBlockSeconds) },
+        { "Average block",  toMicroseconds(m_snapshot.averageBlockSeconds) },
+        { "Slowest block",  toMicroseconds(m_snapshot.maxBlockSeconds) },
+        { "Average budget", toPercent(m_snapshot.averageBudgetUsed) },
+        { "Most budget",    toPercent(m_snapshot.maxBudgetUsed) },
+        { "Over budget",    juce::String(static_cast<juce::int64>(m_snapshot.numOverBudgetBlocks)) },
+    };
+
+    auto textArea = bounds.removeFromLeft(240);
+    for (const auto &line : lines)
+    {
+        auto row = textArea.removeFromTop(22);
+        g.drawText(line.first, row.removeFromLeft(120), juce::Justification::centredLeft);
+        g.drawText(line.second, row, juce::Justification::centredRight);
+    }
+
+    // The histogram of budget used, on the right.
+    bounds.removeFromLeft(20);
+    auto labelArea = bounds.removeFromBottom(20);
+    g.drawText("Budget used per block", bounds.removeFromTop(22), juce::Justification::centred);
+
+    uint64_t tallest = 1;
+    for (uint64_t count : m_snapshot.histogram)
+        tallest = std::max(tallest, count);
+
+    const int numBins = PerformanceMonitor::NUM_HISTOGRAM_BINS;
+    const float binWidth = bounds.getWidth() / static_cast<float>(numBins);
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const float height = bounds.getHeight() * static_cast<float>(m_snapshot.histogram[static_cast<size_t>(bin)]) / tallest;
+        const juce::Rectangle<float> bar(bounds.getX() + bin * binWidth + 2.0f, bounds.getBottom() - height, binWidth - 4.0f, height);
+        g.fillRect(bar);
+
+        const juce::String label = (bin == numBins - 1) ? ">" : juce::String(bin * 10);
+        g.drawText(label, juce::Rectangle<float>(labelArea.getX() + bin * binWidth, static_cast<float>(labelArea.getY()),
+            binWidth, static_cast<float>(labelArea.getHeight())), juce::Justification::centred);
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void PerformancePanel::resized()
+{
+    const auto bounds = getLocalBounds();
+    m_closeButton.setBounds(bounds.getRight() - 90, bounds.getBottom() - 45, 70, 25);
+    m_resetButton.setBounds(bounds.getRight() - 170, bounds.getBottom() - 45, 70, 25);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void PerformancePanel::visibilityChanged()
+{
+    // The counters are kept no matter what. Reading them costs the audio
+    // thread nothing, but there's no point in doing it when nobody's looking.
+    if (isVisible())
+    {
+        timerCallback();
+        startTimerHz(REFRESH_RATE_HZ);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void PerformancePanel::timerCallback()
+{
+    m_snapshot = m_monitor.getSnapshot();
+    repaint();
+}
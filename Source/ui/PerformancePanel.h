@@ -0,0 +1,65 @@
+// MIT License
+//
+// Copyright(C), 2024, Shane Kirk
+
+#pragma once
+
+#include "dsp/PerformanceMonitor.h"
+
+#include <JuceHeader.h>
+
+/**
+ * A hidden page on top of the editor that shows how long the processor
+ * takes per block and how much of each block's time budget that is. Meant
+ * for tracking down dropouts on a user's machine, not for everyday use.
+ * Double-click the title to show or hide it.
+ */
+class PerformancePanel : public juce::Component,
+                         private juce::Timer
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param monitor The counters to show.
+     * @param backgroundColor The panel's background.
+     * @param foregroundColor Text and bars.
+     */
+    PerformancePanel(PerformanceMonitor &monitor, juce::Colour backgroundColor, juce::Colour foregroundColor);
+
+    /**
+     * Draws the counters.
+     */
+    void paint(juce::Graphics &g) override;
+
+    /**
+     * Lays out the buttons.
+     */
+    void resized() override;
+
+    /**
+     * Only polls the counters while the panel is showing.
+     */
+    void visibilityChanged() override;
+
+private:
+
+    /**
+     * Takes a fresh snapshot of the counters and repaints.
+     */
+    void timerCallback() override;
+
+    static constexpr int REFRESH_RATE_HZ = 10; //!< How often the counters are read while showing.
+
+    PerformanceMonitor &m_monitor;               //!< The counters to show.
+    PerformanceMonitor::Snapshot m_snapshot;     //!< The counters as of the last refresh.
+
+    juce::TextButton m_resetButton{ "Reset" };   //!< Starts counting over.
+    juce::TextButton m_closeButton{ "Close" };   //!< Hides the panel.
+
+    const juce::Colour m_backgroundColor; //!< The panel's background.
+    const juce::Colour m_foregroundColor; //!< Text and bars.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerformancePanel)
+};
@@ -5,11 +5,13 @@
 #include "ui/TremoloAudioProcessorEditor.h"
 #include "ui/Version.h"
 #include "dsp/TremoloAudioProcessor.h"
+#include "common/Trace.h"
 
 /**
  * @since 2024 Sept 25
  */
-TremoloAudioProcessorEditor::TremoloAudioProcessorEditor(juce::AudioProcessor &audioProcessor, AudioParameters &audioParams) :
+TremoloAudioProcessorEditor::TremoloAudioProcessorEditor(juce::AudioProcessor &audioProcessor, AudioParameters &audioParams,
+    PerformanceMonitor &performanceMonitor, ScopeFifo &scopeFifo) :
     AudioProcessorEditor(&audioProcessor),
     m_audioParams(audioParams)
 {
@@ -51,10 +53,18 @@ TremoloAudioProcessorEditor::TremoloAudioProcessorEditor(juce::AudioProcessor &a
     m_spTriangleButton = createWaveFormButton(2, *m_audioParams.m_pOscillatorType);
     addAndMakeVisible(*m_spTriangleButton);
 
+    // Scope
+    m_spScope = std::make_unique<LfoScope>(scopeFifo, foregroundColor);
+    addAndMakeVisible(*m_spScope);
+
+    // Performance page. Hidden until the title is double-clicked.
+    m_spPerformancePanel = std::make_unique<PerformancePanel>(performanceMonitor, backgroundGradientBottom, foregroundColor);
+    addChildComponent(*m_spPerformancePanel);
+
     m_audioParams.addListener(this);
 
     // Window size
-    setSize(600, 350);
+    setSize(600, 460);
 }
 
 /**
@@ -70,6 +80,8 @@ TremoloAudioProcessorEditor::~TremoloAudioProcessorEditor()
  */
 void TremoloAudioProcessorEditor::paint(juce::Graphics &g)
 {
+    TREMOLO_TRACE_SCOPE("Editor::paint");
+
     // Background Color
     auto bounds = getLocalBounds();
     auto backgroundGradient = juce::ColourGradient(
@@ -101,13 +113,17 @@ void TremoloAudioProcessorEditor::resized()
 {
     const auto bounds = getLocalBounds();
 
+    // The scope runs along the bottom. The controls are laid out in what's left.
+    const int scopeHeight = 100;
+    const auto controlBounds = bounds.withTrimmedBottom(scopeHeight + 20);
+
     // Title
     m_spTitleDrawable->setTransformToFit(m_titleRect.toFloat(), juce::RectanglePlacement::onlyReduceInSize);
 
     // Knobs
     const int knobWidth = 150;
     const int knobHeight = 150;
-    const int knobYPos = bounds.getCentreY() - (knobHeight / 2) - 20;
+    const int knobYPos = controlBounds.getCentreY() - (knobHeight / 2) - 10;
     int knobXPos = 50;
     m_spSpeedKnob->setBounds(knobXPos, knobYPos, knobWidth, knobHeight);
 
@@ -127,6 +143,19 @@ void TremoloAudioProcessorEditor::resized()
     m_spTriangleButton->setBounds(buttonX + (buttonWidth + 20), buttonY, buttonWidth, buttonHeight);
 
     m_spAboutButton->setBounds(bounds.getWidth() - 34, 8, 26, 26);
+
+    m_spScope->setBounds(50, buttonY + buttonHeight + 15, bounds.getWidth() - 100, scopeHeight);
+
+    m_spPerformancePanel->setBounds(bounds);
+}
+
+/**
+ * @since 2026 Oct 16
+ */
+void TremoloAudioProcessorEditor::mouseDoubleClick(const juce::MouseEvent &event)
+{
+    if (m_titleRect.contains(event.getPosition()))
+        m_spPerformancePanel->setVisible(!m_spPerformancePanel->isVisible());
 }
 
 /**
@@ -134,6 +163,8 @@ void TremoloAudioProcessorEditor::resized()
  */
 void TremoloAudioProcessorEditor::parameterValueChanged(int parameterIndex, float newValue)
 {
+    TREMOLO_TRACE_SCOPE("Editor::parameterValueChanged");
+
     switch (parameterIndex)
     {
         case 0:
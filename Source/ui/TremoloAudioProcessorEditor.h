@@ -6,6 +6,8 @@
 
 #include "ui/IconButton.h"
 #include "ui/Knob.h"
+#include "ui/LfoScope.h"
+#include "ui/PerformancePanel.h"
 #include "common/AudioParams.h"
 
 #include <JuceHeader.h>
@@ -24,9 +26,11 @@ public:
      *
      * @param audioProcessor I don't like this circular reference. But I'm not sure how to avoid it since the base class requires it.
      * @param audioParams The parameters the UI controls will be manipulating.
+     * @param performanceMonitor The processor's block timing, for the hidden performance page.
+     * @param scopeFifo The processor's modulation and output envelope, for the scope.
      */
     TremoloAudioProcessorEditor(juce::AudioProcessor &audioProcessor,
-        AudioParameters &audioParams);
+        AudioParameters &audioParams, PerformanceMonitor &performanceMonitor, ScopeFifo &scopeFifo);
 
     /**
      * Destructor.
@@ -46,6 +50,11 @@ public:
      */
     void resized() override;
 
+    /**
+     * Double-clicking the title shows or hides the performance page.
+     */
+    void mouseDoubleClick(const juce::MouseEvent &event) override;
+
     /*************************************************************************
      AudioProcessorParameter::Listener overrides.
      *************************************************************************/
@@ -104,6 +113,10 @@ private:
     std::unique_ptr<IconButton> m_spSquareButton;   //!< Allows user to enable a square wave volume envelope.
     std::unique_ptr<IconButton> m_spTriangleButton; //!< Allows user to enable a triangle wave volume envelope.
 
+    std::unique_ptr<LfoScope> m_spScope; //!< Shows the modulation curve and output envelope.
+
+    std::unique_ptr<PerformancePanel> m_spPerformancePanel; //!< The hidden performance page. Covers everything else while showing.
+
     const juce::Rectangle<int> m_titleRect { 48, 0, 200, 65 }; //!< The region that m_spTitleGraphic occupies. We cache this to use as a clipping region for our border.
 
     constexpr static const int RADIO_BUTTON_GROUP_ID = 1; //! Button group to use for all radio buttons.